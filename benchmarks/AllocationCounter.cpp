@@ -0,0 +1,37 @@
+#include "AllocationCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    thread_local std::size_t allocationCount = 0;
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    ++allocationCount;
+    if (void *ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace Kappa::Benchmarks
+{
+    std::size_t AllocationCounter::Count()
+    {
+        return allocationCount;
+    }
+} // namespace Kappa::Benchmarks
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Kappa::Benchmarks
+{
+    /**
+     * @brief Counts global heap allocations made by the current thread.
+     * @note Backed by replacement global operator new/delete in AllocationCounter.cpp.
+     */
+    class AllocationCounter
+    {
+    public:
+        /**
+         * @brief Returns the number of allocations made by this thread so far.
+         * @return Allocation count
+         */
+        [[nodiscard]] static std::size_t Count();
+    };
+} // namespace Kappa::Benchmarks
@@ -0,0 +1,420 @@
+#include "AllocationCounter.h"
+#include "Kappa/EventBus.h"
+#include "Kappa/EventStream.h"
+#include "Kappa/StaticEventBus.h"
+#include "Kappa/ThreadPool.h"
+#include "LegacyEventBus.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace Kappa;
+using Kappa::Benchmarks::AllocationCounter;
+using Kappa::Benchmarks::LegacyEventBus;
+
+namespace
+{
+    struct TickEvent : public Event
+    {
+        explicit TickEvent(int val) : value(val)
+        {
+        }
+        int value;
+    };
+
+    struct UnrelatedEvent : public Event
+    {
+    };
+
+    using StaticTickBus = StaticEventBus<TickEvent, UnrelatedEvent>;
+
+    /**
+     * @brief Keeps handlers registered regardless of whether the bus hands out subscription tokens.
+     */
+    class SubscriptionKeeper
+    {
+    public:
+        template<typename TEvent, typename TBus, typename TCallback> void Add(TBus &bus, TCallback &&callback)
+        {
+            using Result = decltype(bus.template Subscribe<TEvent>(std::forward<TCallback>(callback)));
+            if constexpr (std::is_void_v<Result>)
+            {
+                bus.template Subscribe<TEvent>(std::forward<TCallback>(callback));
+            }
+            else
+            {
+                tokens.push_back(bus.template Subscribe<TEvent>(std::forward<TCallback>(callback)));
+            }
+        }
+
+        void Clear()
+        {
+            tokens.clear();
+        }
+
+    private:
+        std::vector<Subscription> tokens;
+    };
+
+    /**
+     * @brief Publishes one event per iteration to `range(0)` handlers.
+     */
+    template<typename TBus> void PublishFanOut(benchmark::State &state)
+    {
+        TBus bus;
+        SubscriptionKeeper keeper;
+        std::int64_t sink = 0;
+        for (std::int64_t i = 0; i < state.range(0); ++i)
+        {
+            keeper.Add<TickEvent>(bus, [&sink](const TickEvent &event) { sink += event.value; });
+        }
+
+        // A second registered type makes the legacy hash lookup realistic
+        keeper.Add<UnrelatedEvent>(bus, [](const UnrelatedEvent &) {});
+
+        const TickEvent event(1);
+        const auto allocationsBefore = AllocationCounter::Count();
+        for (auto _ : state)
+        {
+            bus.Publish(event);
+        }
+        const auto allocations = AllocationCounter::Count() - allocationsBefore;
+
+        benchmark::DoNotOptimize(sink);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.counters["allocs/publish"] =
+            benchmark::Counter(static_cast<double>(allocations) / static_cast<double>(state.iterations()));
+    }
+
+    /**
+     * @brief Publishes an event type nobody subscribed to.
+     */
+    template<typename TBus> void PublishNoSubscribers(benchmark::State &state)
+    {
+        TBus bus;
+        SubscriptionKeeper keeper;
+        keeper.Add<UnrelatedEvent>(bus, [](const UnrelatedEvent &) {});
+
+        const TickEvent event(1);
+        for (auto _ : state)
+        {
+            bus.Publish(event);
+        }
+    }
+
+    /**
+     * @brief Measures the cost of adding a handler to an already populated event type.
+     */
+    template<typename TBus> void SubscribeOne(benchmark::State &state)
+    {
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            {
+                TBus bus;
+                SubscriptionKeeper keeper;
+                for (std::int64_t i = 0; i < state.range(0); ++i)
+                {
+                    keeper.Add<TickEvent>(bus, [](const TickEvent &) {});
+                }
+                state.ResumeTiming();
+
+                keeper.Add<TickEvent>(bus, [](const TickEvent &) {});
+
+                state.PauseTiming();
+                keeper.Clear();
+            }
+            state.ResumeTiming();
+        }
+    }
+
+    /**
+     * @brief Measures removing a handler from the middle of a populated event type.
+     */
+    void UnsubscribeOne(benchmark::State &state)
+    {
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            {
+                EventBus bus;
+                std::vector<Subscription> tokens;
+                for (std::int64_t i = 0; i < state.range(0); ++i)
+                {
+                    tokens.push_back(bus.Subscribe<TickEvent>([](const TickEvent &) {}));
+                }
+                state.ResumeTiming();
+
+                tokens[tokens.size() / 2].Reset();
+
+                state.PauseTiming();
+            }
+            state.ResumeTiming();
+        }
+    }
+
+    /**
+     * @brief Every benchmark thread publishes to one shared bus with a handful of cheap handlers.
+     * @note Publish throughput should scale with thread count once publishers no longer share a mutex.
+     */
+    template<typename TBus> void PublishContended(benchmark::State &state)
+    {
+        static TBus bus;
+        static SubscriptionKeeper keeper;
+        static std::once_flag subscribed;
+        std::call_once(subscribed, [] {
+            for (int i = 0; i < 4; ++i)
+            {
+                keeper.Add<TickEvent>(bus, [](const TickEvent &event) { benchmark::DoNotOptimize(event.value); });
+            }
+        });
+
+        const TickEvent event(state.thread_index());
+        for (auto _ : state)
+        {
+            bus.Publish(event);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    constexpr int batchHandlerCount = 4;
+
+    /**
+     * @brief Publishes `range(0)` events per iteration with one Publish call each.
+     */
+    template<typename TBus> void PublishEach(benchmark::State &state)
+    {
+        TBus bus;
+        SubscriptionKeeper keeper;
+        std::int64_t sink = 0;
+        for (int i = 0; i < batchHandlerCount; ++i)
+        {
+            keeper.Add<TickEvent>(bus, [&sink](const TickEvent &event) { sink += event.value; });
+        }
+
+        const std::vector<TickEvent> events(static_cast<std::size_t>(state.range(0)), TickEvent(1));
+        for (auto _ : state)
+        {
+            for (const auto &event : events)
+            {
+                bus.Publish(event);
+            }
+        }
+
+        benchmark::DoNotOptimize(sink);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    /**
+     * @brief Publishes `range(0)` events per iteration with a single PublishBatch call.
+     * @note `range(1)` selects batch-aware handlers (1) or per-event handlers behind the adapter (0).
+     */
+    void PublishBatched(benchmark::State &state)
+    {
+        EventBus bus;
+        std::vector<Subscription> tokens;
+        std::int64_t sink = 0;
+        for (int i = 0; i < batchHandlerCount; ++i)
+        {
+            if (state.range(1))
+            {
+                tokens.push_back(bus.SubscribeBatch<TickEvent>([&sink](std::span<const TickEvent> batch) {
+                    for (const auto &event : batch)
+                    {
+                        sink += event.value;
+                    }
+                }));
+            }
+            else
+            {
+                tokens.push_back(bus.Subscribe<TickEvent>([&sink](const TickEvent &event) { sink += event.value; }));
+            }
+        }
+
+        const std::vector<TickEvent> events(static_cast<std::size_t>(state.range(0)), TickEvent(1));
+        for (auto _ : state)
+        {
+            bus.PublishBatch(std::span<const TickEvent>(events));
+        }
+
+        benchmark::DoNotOptimize(sink);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    /**
+     * @brief Simulates a frame of `range(0)` input events (e.g. mouse moves) reaching `batchHandlerCount` handlers.
+     * @note `range(1)` publishes each event immediately (0) or coalesces them and dispatches once (1).
+     */
+    void PublishInputFlood(benchmark::State &state)
+    {
+        EventBus bus;
+        std::vector<Subscription> tokens;
+        std::int64_t sink = 0;
+        for (int i = 0; i < batchHandlerCount; ++i)
+        {
+            tokens.push_back(bus.Subscribe<TickEvent>([&sink](const TickEvent &event) { sink += event.value; }));
+        }
+
+        for (auto _ : state)
+        {
+            for (std::int64_t i = 0; i < state.range(0); ++i)
+            {
+                if (state.range(1))
+                {
+                    bus.Coalesce(TickEvent(static_cast<int>(i)));
+                }
+                else
+                {
+                    bus.Publish(TickEvent(static_cast<int>(i)));
+                }
+            }
+            bus.DispatchQueued();
+        }
+
+        benchmark::DoNotOptimize(sink);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    /**
+     * @brief Writes `range(0)` events into an EventStream and has `batchHandlerCount` readers pull them.
+     * @note The pull-model counterpart of PublishEach with the same number of consumers.
+     */
+    void StreamFrame(benchmark::State &state)
+    {
+        EventStream<TickEvent> stream;
+        std::int64_t sink = 0;
+        const auto allocationsBefore = AllocationCounter::Count();
+        for (auto _ : state)
+        {
+            for (std::int64_t i = 0; i < state.range(0); ++i)
+            {
+                stream.Emplace(static_cast<int>(i));
+            }
+            stream.Swap();
+
+            for (int reader = 0; reader < batchHandlerCount; ++reader)
+            {
+                for (const auto &event : stream.Read())
+                {
+                    sink += event.value;
+                }
+            }
+        }
+        const auto allocations = AllocationCounter::Count() - allocationsBefore;
+
+        benchmark::DoNotOptimize(sink);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.counters["allocs/frame"] =
+            benchmark::Counter(static_cast<double>(allocations) / static_cast<double>(state.iterations()));
+    }
+
+    /**
+     * @brief Publishes to `range(0)` heavy handlers (a few microseconds of math each).
+     * @note `range(1)` subscribes them as concurrent-safe (1) or sequential (0). The pool uses the default
+     *       worker count, so the speedup tracks the number of hardware threads.
+     */
+    void PublishHeavyFanOut(benchmark::State &state)
+    {
+        ThreadPool pool;
+        EventBus bus;
+        bus.SetThreadPool(&pool);
+
+        std::vector<Subscription> tokens;
+        const auto heavyWork = [](const TickEvent &event) {
+            double accumulator = event.value;
+            for (int i = 0; i < 2000; ++i)
+            {
+                accumulator = std::sqrt(accumulator + i);
+            }
+            benchmark::DoNotOptimize(accumulator);
+        };
+        for (std::int64_t i = 0; i < state.range(0); ++i)
+        {
+            tokens.push_back(state.range(1) ? bus.SubscribeConcurrent<TickEvent>(heavyWork)
+                                            : bus.Subscribe<TickEvent>(heavyWork));
+        }
+
+        const TickEvent event(1);
+        for (auto _ : state)
+        {
+            bus.Publish(event);
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.counters["workers"] = benchmark::Counter(static_cast<double>(pool.GetWorkerCount()));
+    }
+
+    /**
+     * @brief Publishes one event to one entity among `range(0)` entities that each listen for their own.
+     * @note `range(1)` uses keyed subscriptions (1) or wildcard handlers that compare the ID themselves (0).
+     */
+    void PublishToEntity(benchmark::State &state)
+    {
+        EventBus bus;
+        std::vector<Subscription> tokens;
+        std::int64_t sink = 0;
+        for (std::int64_t entity = 0; entity < state.range(0); ++entity)
+        {
+            const auto key = static_cast<std::uint64_t>(entity);
+            if (state.range(1))
+            {
+                tokens.push_back(
+                    bus.Subscribe<TickEvent>(key, [&sink](const TickEvent &event) { sink += event.value; }));
+            }
+            else
+            {
+                tokens.push_back(bus.Subscribe<TickEvent>([&sink, entity](const TickEvent &event) {
+                    if (event.value == entity)
+                    {
+                        sink += event.value;
+                    }
+                }));
+            }
+        }
+
+        std::int64_t target = 0;
+        for (auto _ : state)
+        {
+            const TickEvent event(static_cast<int>(target));
+            if (state.range(1))
+            {
+                bus.Publish(static_cast<std::uint64_t>(target), event);
+            }
+            else
+            {
+                bus.Publish(event);
+            }
+            target = (target + 1) % state.range(0);
+        }
+
+        benchmark::DoNotOptimize(sink);
+        state.SetItemsProcessed(state.iterations());
+    }
+} // namespace
+
+BENCHMARK(PublishFanOut<LegacyEventBus>)->Arg(1)->Arg(8)->Arg(64);
+BENCHMARK(PublishFanOut<EventBus>)->Arg(1)->Arg(8)->Arg(64);
+BENCHMARK(PublishFanOut<StaticTickBus>)->Arg(1)->Arg(8)->Arg(64);
+BENCHMARK(PublishNoSubscribers<LegacyEventBus>);
+BENCHMARK(PublishNoSubscribers<EventBus>);
+BENCHMARK(PublishNoSubscribers<StaticTickBus>);
+BENCHMARK(SubscribeOne<LegacyEventBus>)->Arg(8)->Arg(64);
+BENCHMARK(SubscribeOne<EventBus>)->Arg(8)->Arg(64);
+BENCHMARK(UnsubscribeOne)->Arg(8)->Arg(64);
+BENCHMARK(PublishContended<LegacyEventBus>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(PublishContended<EventBus>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(PublishEach<LegacyEventBus>)->Arg(1024);
+BENCHMARK(PublishEach<EventBus>)->Arg(1024);
+BENCHMARK(PublishBatched)->Args({ 1024, 0 })->Args({ 1024, 1 });
+BENCHMARK(StreamFrame)->Arg(1024);
+BENCHMARK(PublishInputFlood)->Args({ 1000, 0 })->Args({ 1000, 1 });
+BENCHMARK(PublishToEntity)->ArgsProduct({ { 16, 1024, 10000 }, { 0, 1 } });
+BENCHMARK(PublishHeavyFanOut)->ArgsProduct({ { 8, 32 }, { 0, 1 } })->UseRealTime();
@@ -0,0 +1,125 @@
+#include "Kappa/EventBus.h"
+#include "Kappa/EventRecording.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+using namespace Kappa;
+
+namespace
+{
+    struct PointerMovedEvent : public Event
+    {
+        PointerMovedEvent(float x, float y) : x(x), y(y)
+        {
+        }
+        float x;
+        float y;
+    };
+
+    std::string RecordingPath()
+    {
+        return (std::filesystem::temp_directory_path() / "kappa_benchmark.kevr").string();
+    }
+} // namespace
+
+template<> struct Kappa::EventSerializer<PointerMovedEvent>
+{
+    static void Write(BinaryWriter &writer, const PointerMovedEvent &event)
+    {
+        writer.Write(event.x);
+        writer.Write(event.y);
+    }
+
+    static PointerMovedEvent Read(BinaryReader &reader)
+    {
+        const auto x = reader.Read<float>();
+        const auto y = reader.Read<float>();
+        return PointerMovedEvent(x, y);
+    }
+};
+
+namespace
+{
+    /**
+     * @brief Publishes one frame of `range(0)` events per iteration with a recorder attached.
+     * @note Compare with the recorder disabled (`range(1)` = 0) to see the recording overhead.
+     */
+    void RecordFrame(benchmark::State &state)
+    {
+        EventBus bus;
+        std::int64_t sink = 0;
+        auto subscription = bus.Subscribe<PointerMovedEvent>(
+            [&sink](const PointerMovedEvent &event) { sink += static_cast<std::int64_t>(event.x); });
+
+        EventRecorder recorder(bus);
+        if (state.range(1))
+        {
+            recorder.Record<PointerMovedEvent>();
+            recorder.Open(RecordingPath());
+        }
+
+        for (auto _ : state)
+        {
+            for (std::int64_t i = 0; i < state.range(0); ++i)
+            {
+                bus.Publish(PointerMovedEvent(static_cast<float>(i), 0.0f));
+            }
+            recorder.EndFrame();
+        }
+
+        recorder.Close();
+        std::filesystem::remove(RecordingPath());
+        benchmark::DoNotOptimize(sink);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    /**
+     * @brief Replays a 600-frame recording with `range(0)` events per frame.
+     */
+    void ReplayRecording(benchmark::State &state)
+    {
+        constexpr int frameCount = 600;
+        {
+            EventBus bus;
+            EventRecorder recorder(bus);
+            recorder.Record<PointerMovedEvent>();
+            recorder.Open(RecordingPath());
+            for (int frame = 0; frame < frameCount; ++frame)
+            {
+                for (std::int64_t i = 0; i < state.range(0); ++i)
+                {
+                    bus.Publish(PointerMovedEvent(static_cast<float>(i), static_cast<float>(frame)));
+                }
+                recorder.EndFrame();
+            }
+        }
+
+        EventReplayer replayer;
+        replayer.Open(RecordingPath());
+        replayer.Register<PointerMovedEvent>();
+
+        EventBus bus;
+        std::int64_t sink = 0;
+        auto subscription = bus.Subscribe<PointerMovedEvent>(
+            [&sink](const PointerMovedEvent &event) { sink += static_cast<std::int64_t>(event.y); });
+
+        for (auto _ : state)
+        {
+            replayer.Rewind();
+            while (replayer.PublishFrame(bus))
+            {
+            }
+        }
+
+        std::filesystem::remove(RecordingPath());
+        benchmark::DoNotOptimize(sink);
+        state.SetItemsProcessed(state.iterations() * frameCount * state.range(0));
+    }
+} // namespace
+
+BENCHMARK(RecordFrame)->Args({ 64, 0 })->Args({ 64, 1 });
+BENCHMARK(ReplayRecording)->Arg(1)->Arg(64);
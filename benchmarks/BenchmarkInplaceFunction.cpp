@@ -0,0 +1,85 @@
+#include "AllocationCounter.h"
+#include "Kappa/InplaceFunction.h"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+using namespace Kappa;
+using Kappa::Benchmarks::AllocationCounter;
+
+namespace
+{
+    template<std::size_t CaptureSize> struct Capture
+    {
+        std::array<std::byte, CaptureSize> data{};
+    };
+
+    using Inplace = InplaceFunction<void(std::int64_t &), 64>;
+    using Standard = std::function<void(std::int64_t &)>;
+
+    /**
+     * @brief Builds a callable capturing `CaptureSize` bytes.
+     */
+    template<std::size_t CaptureSize> auto MakeCallable()
+    {
+        return [capture = Capture<CaptureSize>{}](std::int64_t &sink) {
+            sink += static_cast<std::int64_t>(capture.data[0]) + 1;
+        };
+    }
+
+    /**
+     * @brief Calls a vector of `range(0)` type-erased callables, like an event fan-out.
+     */
+    template<typename TFunction, std::size_t CaptureSize> void Call(benchmark::State &state)
+    {
+        std::vector<TFunction> functions;
+        for (std::int64_t i = 0; i < state.range(0); ++i)
+        {
+            functions.emplace_back(MakeCallable<CaptureSize>());
+        }
+
+        std::int64_t sink = 0;
+        for (auto _ : state)
+        {
+            for (const auto &function : functions)
+            {
+                function(sink);
+            }
+        }
+
+        benchmark::DoNotOptimize(sink);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.counters["bytes/function"] = benchmark::Counter(static_cast<double>(sizeof(TFunction)));
+    }
+
+    /**
+     * @brief Constructs and destroys a callable, reporting heap allocations per construction.
+     */
+    template<typename TFunction, std::size_t CaptureSize> void Construct(benchmark::State &state)
+    {
+        const auto allocationsBefore = AllocationCounter::Count();
+        for (auto _ : state)
+        {
+            TFunction function(MakeCallable<CaptureSize>());
+            benchmark::DoNotOptimize(&function);
+        }
+        const auto allocations = AllocationCounter::Count() - allocationsBefore;
+
+        state.counters["allocs/construct"] =
+            benchmark::Counter(static_cast<double>(allocations) / static_cast<double>(state.iterations()));
+    }
+} // namespace
+
+BENCHMARK(Call<Standard, 8>)->Arg(1)->Arg(64);
+BENCHMARK(Call<Inplace, 8>)->Arg(1)->Arg(64);
+BENCHMARK(Call<Standard, 48>)->Arg(1)->Arg(64);
+BENCHMARK(Call<Inplace, 48>)->Arg(1)->Arg(64);
+BENCHMARK(Construct<Standard, 8>);
+BENCHMARK(Construct<Inplace, 8>);
+BENCHMARK(Construct<Standard, 48>);
+BENCHMARK(Construct<Inplace, 48>);
@@ -0,0 +1,127 @@
+#include "AllocationCounter.h"
+
+#include "Kappa/EventBus.h"
+#include "Kappa/Task.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace Kappa;
+using Kappa::Benchmarks::AllocationCounter;
+
+namespace
+{
+    struct AssetLoadedEvent : public Event
+    {
+        explicit AssetLoadedEvent(int id) : id(id)
+        {
+        }
+        int id;
+    };
+
+    Task<> WaitFrames(int frames, std::int64_t &sink)
+    {
+        for (int i = 0; i < frames; ++i)
+        {
+            co_await NextFrame();
+        }
+        sink++;
+    }
+
+    Task<int> LoadStep(int value)
+    {
+        co_await NextFrame();
+        co_return value + 1;
+    }
+
+    Task<> LoadSequence(EventBus &bus, std::int64_t &sink)
+    {
+        const auto loaded = co_await bus.Next<AssetLoadedEvent>();
+        sink += co_await LoadStep(loaded.id);
+    }
+
+    /**
+     * @brief Spawns `range(0)` tasks that each wait two frames, and runs them to completion.
+     * @note Reports heap allocations per round; frames are recycled through the task frame pool, so only
+     *       the scheduler's own vectors allocate, and only while they grow during the first rounds.
+     */
+    void SpawnAndFinishTasks(benchmark::State &state)
+    {
+        TaskScheduler scheduler;
+        std::vector<Subscription> tokens;
+        tokens.reserve(static_cast<std::size_t>(state.range(0)));
+        std::int64_t sink = 0;
+
+        const auto allocationsBefore = AllocationCounter::Count();
+        for (auto _ : state)
+        {
+            for (std::int64_t i = 0; i < state.range(0); ++i)
+            {
+                tokens.push_back(scheduler.Spawn(WaitFrames(2, sink)));
+            }
+            scheduler.Update(0.016f);
+            scheduler.Update(0.016f);
+            tokens.clear();
+        }
+        const auto allocations = AllocationCounter::Count() - allocationsBefore;
+
+        benchmark::DoNotOptimize(sink);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.counters["allocs/round"] =
+            benchmark::Counter(static_cast<double>(allocations) / static_cast<double>(state.iterations()));
+    }
+
+    /**
+     * @brief Resumes `range(0)` long-running tasks once per update.
+     */
+    void ResumeTasks(benchmark::State &state)
+    {
+        TaskScheduler scheduler;
+        std::vector<Subscription> tokens;
+        std::int64_t sink = 0;
+        for (std::int64_t i = 0; i < state.range(0); ++i)
+        {
+            tokens.push_back(scheduler.Spawn(WaitFrames(1 << 30, sink)));
+        }
+
+        for (auto _ : state)
+        {
+            scheduler.Update(0.016f);
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    /**
+     * @brief Runs `range(0)` tasks through an event wait and an awaited child task.
+     * @note Every waiting task is a bus subscriber, so the copy-on-write subscribe cost grows with the
+     *       number of tasks waiting on the same event type.
+     */
+    void AwaitEventThenChild(benchmark::State &state)
+    {
+        EventBus bus;
+        TaskScheduler scheduler;
+        std::vector<Subscription> tokens;
+        std::int64_t sink = 0;
+        for (auto _ : state)
+        {
+            for (std::int64_t i = 0; i < state.range(0); ++i)
+            {
+                tokens.push_back(scheduler.Spawn(LoadSequence(bus, sink)));
+            }
+            bus.Publish(AssetLoadedEvent(1));
+            scheduler.Update(0.016f);
+            scheduler.Update(0.016f);
+            tokens.clear();
+        }
+
+        benchmark::DoNotOptimize(sink);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+} // namespace
+
+BENCHMARK(SpawnAndFinishTasks)->Arg(1000)->Arg(10000);
+BENCHMARK(ResumeTasks)->Arg(1000)->Arg(10000);
+BENCHMARK(AwaitEventThenChild)->Arg(1000);
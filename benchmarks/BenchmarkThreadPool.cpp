@@ -0,0 +1,145 @@
+#include "Kappa/ThreadPool.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace Kappa;
+
+namespace
+{
+    /**
+     * @brief Adds thread counts 1, 2, 4, ... up to the hardware thread count, which is always included.
+     * @note The calling thread participates in ParallelFor and Wait, so `threads` runs with `threads - 1` workers.
+     */
+    void ThreadCounts(benchmark::internal::Benchmark *benchmark)
+    {
+        const auto hardwareThreads = static_cast<std::int64_t>(std::max(std::thread::hardware_concurrency(), 1u));
+        for (std::int64_t threads = 1; threads < hardwareThreads; threads *= 2)
+        {
+            benchmark->Arg(threads);
+        }
+        benchmark->Arg(hardwareThreads);
+        benchmark->UseRealTime();
+    }
+
+    /**
+     * @brief Compute-bound ParallelFor over a million elements with automatic chunking.
+     */
+    void ParallelForScaling(benchmark::State &state)
+    {
+        ThreadPool pool(static_cast<std::size_t>(state.range(0) - 1));
+        std::vector<float> values(1 << 20, 1.5f);
+
+        for (auto _ : state)
+        {
+            pool.ParallelFor(values.size(), [&values](std::size_t i) {
+                values[i] = std::sqrt(values[i] * values[i] + 1.0f);
+            });
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+    }
+
+    /**
+     * @brief Same loop claiming one index at a time, the cost automatic chunking avoids.
+     */
+    void ParallelForUnchunked(benchmark::State &state)
+    {
+        ThreadPool pool(static_cast<std::size_t>(state.range(0) - 1));
+        std::vector<float> values(1 << 20, 1.5f);
+
+        for (auto _ : state)
+        {
+            pool.ParallelFor(values.size(), 1, [&values](std::size_t i) {
+                values[i] = std::sqrt(values[i] * values[i] + 1.0f);
+            });
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+    }
+
+    /**
+     * @brief Fan-out/fan-in graph: 256 independent jobs of ~10 µs each followed by one joining job.
+     */
+    void TaskGraphFanOutFanIn(benchmark::State &state)
+    {
+        ThreadPool pool(static_cast<std::size_t>(state.range(0) - 1));
+        std::vector<JobHandle> children(256);
+        std::atomic<std::uint64_t> sink{ 0 };
+
+        for (auto _ : state)
+        {
+            for (auto &child : children)
+            {
+                child = pool.Submit(
+                    [&sink] {
+                        std::uint64_t value = 0;
+                        for (int i = 0; i < 4000; ++i)
+                        {
+                            benchmark::DoNotOptimize(value += static_cast<std::uint64_t>(i) * 2654435761u);
+                        }
+                        sink.fetch_add(value, std::memory_order_relaxed);
+                    },
+                    {});
+            }
+            const auto join = pool.Submit([] {}, children);
+            pool.Wait(join);
+        }
+
+        benchmark::DoNotOptimize(sink.load());
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(children.size()));
+    }
+
+    /**
+     * @brief A worker spawns small tasks into its own deque; the others have to steal them.
+     */
+    void StealSpawnedTasks(benchmark::State &state)
+    {
+        ThreadPool pool(static_cast<std::size_t>(state.range(0) - 1));
+        constexpr int taskCount = 4096;
+        std::atomic<int> remaining{ 0 };
+
+        for (auto _ : state)
+        {
+            remaining.store(taskCount, std::memory_order_relaxed);
+            const auto spawner = pool.Submit(
+                [&pool, &remaining] {
+                    for (int i = 0; i < taskCount; ++i)
+                    {
+                        pool.Submit([&remaining] {
+                            std::uint64_t value = 0;
+                            for (int j = 0; j < 500; ++j)
+                            {
+                                benchmark::DoNotOptimize(value += static_cast<std::uint64_t>(j));
+                            }
+                            remaining.fetch_sub(1, std::memory_order_release);
+                        });
+                    }
+                },
+                {});
+            pool.Wait(spawner);
+            while (remaining.load(std::memory_order_acquire) != 0)
+            {
+                if (!pool.TryRunPending())
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * taskCount);
+    }
+} // namespace
+
+BENCHMARK(ParallelForScaling)->Apply(ThreadCounts);
+BENCHMARK(ParallelForUnchunked)->Apply(ThreadCounts);
+BENCHMARK(TaskGraphFanOutFanIn)->Apply(ThreadCounts);
+BENCHMARK(StealSpawnedTasks)->Apply(ThreadCounts);
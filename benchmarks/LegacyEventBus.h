@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Kappa/Event.h"
+
+#include <functional>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace Kappa::Benchmarks
+{
+    /**
+     * @brief The original EventBus implementation, kept verbatim as a baseline for comparison.
+     * @note Hashes a std::type_index, copies the handler vector and dynamic_casts on every publish.
+     */
+    class LegacyEventBus
+    {
+    public:
+        template<typename TEvent>
+            requires std::is_base_of_v<Event, TEvent>
+        void Subscribe(std::function<void(const TEvent &)> callback)
+        {
+            std::lock_guard<std::mutex> lock(subscribersMutex);
+            const auto typeIndex = std::type_index(typeid(TEvent));
+            auto wrapper = [callback](const Event &event) {
+                if (const auto *specEvent = dynamic_cast<const TEvent *>(&event))
+                {
+                    callback(*specEvent);
+                }
+            };
+            subscribers[typeIndex].push_back(wrapper);
+        }
+
+        template<typename TEvent>
+            requires std::is_base_of_v<Event, TEvent>
+        void Publish(const TEvent &event)
+        {
+            std::vector<EventCallback> handlers;
+            {
+                std::lock_guard<std::mutex> lock(subscribersMutex);
+                const auto typeIndex = std::type_index(typeid(TEvent));
+                if (const auto it = subscribers.find(typeIndex); it != subscribers.end())
+                {
+                    handlers = it->second;
+                }
+            }
+
+            for (const auto &callback : handlers)
+            {
+                callback(event);
+            }
+        }
+
+        void Clear()
+        {
+            std::lock_guard<std::mutex> lock(subscribersMutex);
+            subscribers.clear();
+        }
+
+    private:
+        using EventCallback = std::function<void(const Event &)>;
+        std::unordered_map<std::type_index, std::vector<EventCallback>> subscribers;
+        mutable std::mutex subscribersMutex;
+    };
+} // namespace Kappa::Benchmarks
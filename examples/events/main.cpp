@@ -28,7 +28,7 @@ struct ScoreChangedEvent : public Event
 class EventDemoLayer : public Layer
 {
 private:
-    EventBus eventBus;
+    EventBus &eventBus = Application::Get().GetEventBus();
     float playerX = 0.0f;
     float playerY = 0.0f;
     int score = 0;
@@ -37,14 +37,14 @@ private:
 public:
     EventDemoLayer()
     {
-        // Subscribe to custom events
-        eventBus.Subscribe<PlayerMovedEvent>([this](const PlayerMovedEvent &e) {
+        // Subscribe to custom events; the subscriptions are removed when this layer is destroyed
+        eventBus.Subscribe<PlayerMovedEvent>(*this, [this](const PlayerMovedEvent &e) {
             LOG_INFO("Player moved to ({:.2f}, {:.2f})", e.x, e.y);
             playerX = e.x;
             playerY = e.y;
         });
 
-        eventBus.Subscribe<ScoreChangedEvent>([this](const ScoreChangedEvent &e) {
+        eventBus.Subscribe<ScoreChangedEvent>(*this, [this](const ScoreChangedEvent &e) {
             LOG_INFO("Score changed to {}", e.newScore);
             score = e.newScore;
         });
@@ -59,7 +59,8 @@ public:
         {
             float newX = std::sin(time * 0.5f) * 0.5f;
             float newY = std::cos(time * 0.5f) * 0.5f;
-            eventBus.Publish(PlayerMovedEvent(newX, newY));
+            // Only the final position of the frame matters; subscribers get it once, after the update pass
+            eventBus.Coalesce(PlayerMovedEvent(newX, newY));
         }
 
         // Simulate score increase every 3 seconds
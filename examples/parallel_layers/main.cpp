@@ -0,0 +1,132 @@
+#include "Kappa/Application.h"
+#include "Kappa/Layer.h"
+#include "Kappa/Logger.h"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace Kappa;
+
+// Stress test: sixteen CPU-heavy layers own one chunk of particles each, so their updates are independent.
+// The same headless batch runs with parallel layer updates off and on, and the speedup is logged.
+
+constexpr std::size_t ChunkCount = 16;
+constexpr std::size_t ParticlesPerChunk = 20000;
+constexpr std::uint64_t FrameCount = 120;
+
+struct ParticleChunk
+{
+    std::vector<float> positions = std::vector<float>(ParticlesPerChunk, 0.0f);
+    std::vector<float> velocities = std::vector<float>(ParticlesPerChunk, 1.0f);
+};
+
+struct World
+{
+    std::array<ParticleChunk, ChunkCount> chunks;
+    float energy = 0.0f;
+};
+
+// Integrates one chunk; declares that it writes only that chunk
+class ParticleLayer : public Layer
+{
+public:
+    explicit ParticleLayer(ParticleChunk *chunk) : chunk(chunk)
+    {
+        Writes(chunk);
+    }
+
+    void OnUpdate(float deltaTime) override
+    {
+        for (std::size_t i = 0; i < ParticlesPerChunk; ++i)
+        {
+            // Deliberately expensive per-particle work
+            const float drag = std::exp(-0.1f * std::abs(chunk->velocities[i])) * std::cos(chunk->positions[i]);
+            chunk->velocities[i] += drag * deltaTime;
+            chunk->positions[i] += chunk->velocities[i] * deltaTime;
+        }
+    }
+
+private:
+    ParticleChunk *chunk;
+};
+
+// Reads every chunk after the particle layers finished
+class SummaryLayer : public Layer
+{
+public:
+    explicit SummaryLayer(World *world) : world(world)
+    {
+        for (auto &chunk : world->chunks)
+        {
+            Reads(&chunk);
+        }
+        Writes(&world->energy);
+    }
+
+    void OnUpdate(float) override
+    {
+        float energy = 0.0f;
+        for (const auto &chunk : world->chunks)
+        {
+            for (const float velocity : chunk.velocities)
+            {
+                energy += 0.5f * velocity * velocity;
+            }
+        }
+        world->energy = energy;
+    }
+
+private:
+    World *world;
+};
+
+class ParallelLayersApp : public Application
+{
+public:
+    ParallelLayersApp(World &world, bool parallel) : Application(GetSpec(parallel))
+    {
+        for (auto &chunk : world.chunks)
+        {
+            PushLayer<ParticleLayer>(&chunk);
+        }
+        PushLayer<SummaryLayer>(&world);
+    }
+
+private:
+    static ApplicationSpecification GetSpec(bool parallel)
+    {
+        ApplicationSpecification spec;
+        spec.name = parallel ? "Parallel layers" : "Sequential layers";
+        spec.headless = true;
+        spec.headlessTimestep = 1.0f / 60.0f;
+        spec.maxFrames = FrameCount;
+        spec.parallelLayerUpdates = parallel;
+        return spec;
+    }
+};
+
+double RunBatch(bool parallel)
+{
+    World world;
+    ParallelLayersApp app(world, parallel);
+
+    const auto start = std::chrono::steady_clock::now();
+    app.Run();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    LOG_INFO("{}: {} frames in {:.3f} s ({:.1f} FPS), energy {:.1f}", parallel ? "Parallel" : "Sequential",
+             app.GetFrameCount(), seconds, static_cast<double>(app.GetFrameCount()) / seconds, world.energy);
+    return seconds;
+}
+
+int main()
+{
+    const double sequential = RunBatch(false);
+    const double parallel = RunBatch(true);
+    LOG_INFO("Speedup with parallel layer updates: {:.2f}x", sequential / parallel);
+    return 0;
+}
@@ -1,11 +1,29 @@
 #pragma once
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <exception>
 #include <memory>
+#include <optional>
+#include <semaphore>
 #include <span>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "EventBus.h"
+#include "EventChannel.h"
+#include "EventRecording.h"
+#include "EventStream.h"
+#include "FixedTimestep.h"
+#include "FrameLimiter.h"
 #include "Layer.h"
+#include "LayerUpdateGraph.h"
+#include "StaticEventBus.h"
+#include "Task.h"
+#include "ThreadPool.h"
 #include "Window.h"
 
 namespace Kappa
@@ -15,13 +33,40 @@ namespace Kappa
      */
     struct ApplicationSpecification
     {
+        /**
+         * @brief workerThreadCount value that picks ThreadPool::DefaultWorkerCount(), or no workers for an
+         *        instance run by ApplicationRunner.
+         */
+        static constexpr std::size_t AutoWorkerCount = static_cast<std::size_t>(-1);
+
         std::string name = "Application";        ///< Name of the application
         WindowSpecification windowSpecification; ///< Window configuration options
+        float fixedTimestep = 0.0f;              ///< Seconds per Layer::OnFixedUpdate step, 0 disables fixed-step mode
+        int maxFixedStepsPerFrame = 8;           ///< Catch-up cap; time beyond it is dropped
+        float targetFrameRate = 0.0f;            ///< Frame-rate cap in frames per second, 0 leaves pacing to vSync
+        bool reactiveRendering = false;          ///< Run frames only when requested, blocking on events in between
+        float idleTimeout = 0.5f;                ///< Longest block in reactive mode, so EventChannels still drain
+        bool headless = false;                   ///< Run without GLFW, a window or an OpenGL context
+        bool headlessRender = false;             ///< Still call BeginFrame/OnRender/EndFrame in headless mode
+        float headlessTimestep = 0.0f;           ///< Simulated seconds per headless frame, 0 uses measured time
+        std::uint64_t maxFrames = 0;             ///< Run() stops after this many frames, 0 runs until Stop()
+        std::size_t workerThreadCount = AutoWorkerCount; ///< Thread pool size, 0 runs jobs inline
+        bool parallelLayerUpdates = true;        ///< Update layers that declared their data access concurrently
+
+        /**
+         * @brief Update frame N+1 on a simulation thread while the main thread renders frame N.
+         * @note Every layer's OnUpdate() and OnFixedUpdate() then runs off the GLFW/OpenGL thread, including
+         *       layers that declared no Reads/Writes, so they must not call GLFW or OpenGL; hand state to
+         *       OnRender() through a RenderSnapshot instead.
+         */
+        bool pipelinedRendering = false;
     };
 
     /**
      * @brief Base class for applications with layer-based architecture.
-     * @note Only ONE instance should exist at a time (Service Locator pattern).
+     * @note Each thread has at most one current application, reached through Get() (Service Locator pattern).
+     *       The constructor makes the new instance current on the constructing thread and Run() makes it
+     *       current on the running thread, so independent headless instances can run on separate threads.
      */
     class Application
     {
@@ -58,6 +103,7 @@ namespace Kappa
         {
             static_assert(std::is_default_constructible_v<TLayer>, "Layer must be default constructible");
             layerStack.push_back(std::make_unique<TLayer>());
+            layerGraphDirty = true;
         }
 
         /**
@@ -71,23 +117,59 @@ namespace Kappa
         void PushLayer(Args &&...args)
         {
             layerStack.push_back(std::make_unique<TLayer>(std::forward<Args>(args)...));
+            layerGraphDirty = true;
+        }
+
+        /**
+         * @brief Installs a compile-time typed event bus layered on top of the dynamic event bus.
+         * @tparam TBus StaticEventBusWithFallback or StaticEventBus specialization listing the core events
+         * @return The installed bus. A StaticEventBusWithFallback forwards the events it doesn't list to
+         *         GetEventBus(); with a standalone StaticEventBus they don't compile.
+         * @note Call once, from the derived constructor before pushing layers. The dynamic bus keeps working
+         *       beside it, and Run() delivers the static bus's deferred events right after those of the
+         *       dynamic bus. EventChannel still drains into the dynamic bus.
+         */
+        template<typename TBus>
+            requires std::is_base_of_v<StaticEventBusBase, TBus>
+        TBus &UseStaticEventBus()
+        {
+            if (staticEventBus)
+            {
+                throw std::logic_error("Static event bus already installed!");
+            }
+
+            std::unique_ptr<TBus> bus;
+            if constexpr (TBus::HasFallback)
+            {
+                bus = std::make_unique<TBus>(eventBus);
+            }
+            else
+            {
+                bus = std::make_unique<TBus>();
+            }
+            auto &result = *bus;
+            staticEventBus = std::move(bus);
+            staticEventBusType = Detail::EventTypeIndex<TBus>();
+            return result;
         }
 
         /**
          * @brief Returns the framebuffer size.
-         * @return Framebuffer size
+         * @return Framebuffer size; the configured window size in headless mode
          */
         [[nodiscard]] glm::vec2 GetFramebufferSize() const;
 
         /**
          * @brief Returns the main application window.
          * @return Reference to the window
+         * @note Not available in headless mode.
          */
         [[nodiscard]] Window &GetWindow();
 
         /**
          * @brief Returns the main application window.
          * @return Const reference to the window
+         * @note Not available in headless mode.
          */
         [[nodiscard]] const Window &GetWindow() const;
 
@@ -107,14 +189,20 @@ namespace Kappa
 
     public:
         /**
-         * @brief Returns the application instance.
+         * @brief Returns the calling thread's current application.
          * @return Application instance
          */
         [[nodiscard]] static Application &Get();
 
+        /**
+         * @brief Returns the calling thread's current application, if any.
+         * @return Application instance or nullptr
+         */
+        [[nodiscard]] static Application *TryGet();
+
         /**
          * @brief Returns the current time in seconds.
-         * @return Current time
+         * @return Seconds on the monotonic clock since the current application was created, also in headless mode
          */
         [[nodiscard]] static float GetTime();
 
@@ -124,6 +212,148 @@ namespace Kappa
          */
         [[nodiscard]] EventBus &GetEventBus();
 
+        /**
+         * @brief Returns the static event bus installed with UseStaticEventBus().
+         * @tparam TBus The exact StaticEventBus type that was installed
+         * @return Static event bus
+         */
+        template<typename TBus>
+            requires std::is_base_of_v<StaticEventBusBase, TBus>
+        [[nodiscard]] TBus &GetStaticEventBus()
+        {
+            assert(staticEventBus && staticEventBusType == Detail::EventTypeIndex<TBus>());
+            return static_cast<TBus &>(*staticEventBus);
+        }
+
+        /**
+         * @brief Checks whether a static event bus was installed.
+         * @return True after UseStaticEventBus()
+         */
+        [[nodiscard]] bool HasStaticEventBus() const
+        {
+            return staticEventBus != nullptr;
+        }
+
+        /**
+         * @brief Returns the per-frame stream of an event type, creating it on first use.
+         * @tparam TEvent Element type of the stream
+         * @return Stream shared by every caller; Run() swaps it at the end of every frame
+         * @note Write during frame N, read the span in frame N+1. Call from the main thread.
+         */
+        template<typename TEvent> [[nodiscard]] EventStream<TEvent> &GetEventStream()
+        {
+            const auto index = Detail::EventTypeIndex<EventStream<TEvent>>();
+            if (index >= eventStreams.size())
+            {
+                eventStreams.resize(index + 1);
+            }
+
+            if (!eventStreams[index])
+            {
+                eventStreams[index] = std::make_unique<EventStream<TEvent>>();
+                eventStreamOrder.push_back(eventStreams[index].get());
+            }
+
+            return static_cast<EventStream<TEvent> &>(*eventStreams[index]);
+        }
+
+        /**
+         * @brief Sets a recorder whose frame index Run() advances at the end of every frame.
+         * @param recorder Recorder of this application's event bus, or nullptr to detach; must outlive its use
+         */
+        void SetEventRecorder(EventRecorder *recorder);
+
+        /**
+         * @brief Returns the work-stealing job system shared by the framework.
+         * @return Thread pool sized by ApplicationSpecification::workerThreadCount (also runs concurrent
+         *         event handlers)
+         */
+        [[nodiscard]] ThreadPool &GetThreadPool();
+
+        /**
+         * @brief Returns how far rendering lies between the last two fixed steps.
+         * @return Interpolation alpha in [0, 1); 1 when fixed-step mode is disabled
+         * @note Layers blend `previous + (current - previous) * alpha` in OnRender() so a 60 Hz simulation
+         *       still moves smoothly on a faster display. In pipelined mode this is the alpha of the frame
+         *       being rendered, fixed when its snapshots were published.
+         */
+        [[nodiscard]] float GetInterpolationAlpha() const;
+
+        /**
+         * @brief Returns the fixed-step accumulator.
+         * @return Accumulator with step and dropped-step counters, or nullptr when fixed-step mode is disabled
+         */
+        [[nodiscard]] const FixedTimestep *GetFixedTimestep() const;
+
+        /**
+         * @brief Asks for a frame when reactive rendering is enabled.
+         * @note Thread-safe; wakes the loop if it is blocked waiting for events. Window input, NextFrame() and
+         *       due Delay() tasks and events arriving through EventChannels request frames on their own.
+         */
+        void RequestFrame();
+
+        /**
+         * @brief Keeps running frames continuously for a while when reactive rendering is enabled.
+         * @param seconds Duration from now, e.g. the length of an animation; overlapping requests extend
+         * @note Call from the main thread.
+         */
+        void RequestFrames(float seconds);
+
+        /**
+         * @brief Changes the frame-rate cap.
+         * @param targetFrameRate Frames per second; 0 removes the cap
+         * @note Useful with vSync off, where an uncapped loop keeps a core busy.
+         */
+        void SetTargetFrameRate(float targetFrameRate);
+
+        /**
+         * @brief Returns frame pacing measured over the most recent frames.
+         * @return Actual against target frame time, jitter and missed deadlines
+         */
+        [[nodiscard]] FramePacingStats GetFramePacingStats() const;
+
+        /**
+         * @brief Checks whether the application runs without a window.
+         * @return True when created with ApplicationSpecification::headless
+         */
+        [[nodiscard]] bool IsHeadless() const
+        {
+            return !window;
+        }
+
+        /**
+         * @brief Returns the number of frames Run() has completed.
+         * @return Frame count
+         */
+        [[nodiscard]] std::uint64_t GetFrameCount() const
+        {
+            return frameCount;
+        }
+
+        /**
+         * @brief Returns the scheduler that resumes coroutine tasks every frame.
+         * @return Task scheduler; Run() updates it after delivering the deferred events
+         * @note Layers start tasks with `GetTaskScheduler().Spawn(*this, MyTask())` so they end with the layer.
+         */
+        [[nodiscard]] TaskScheduler &GetTaskScheduler();
+
+        /**
+         * @brief Creates a channel through which worker threads deliver events to the main-thread bus.
+         * @tparam TEvent Event type (must derive from Event)
+         * @param spec Channel configuration
+         * @return Shared channel; producers may push from any thread and Run() drains it every frame
+         * @note Call from the main thread.
+         */
+        template<typename TEvent>
+            requires std::is_base_of_v<Event, TEvent>
+        [[nodiscard]] std::shared_ptr<EventChannel<TEvent>> CreateEventChannel(
+            const EventChannelSpecification &spec = EventChannelSpecification())
+        {
+            auto channel = std::make_shared<EventChannel<TEvent>>(spec);
+            eventChannels.push_back(channel);
+            return channel;
+        }
+
         /**
          * @brief Returns a read-only view of the layer stack.
          * @return Span of layers (non-owning view)
@@ -132,10 +362,102 @@ namespace Kappa
         [[nodiscard]] std::span<const std::unique_ptr<Layer>> GetLayers() const;
 
     private:
-        ApplicationSpecification specification;         ///< Application configuration
-        std::vector<std::unique_ptr<Layer>> layerStack; ///< Stack of application layers
-        std::unique_ptr<Window> window;                 ///< Main application window
-        bool isRunning = false;                         ///< Flag indicating if the application is running
-        EventBus eventBus;                              ///< Event bus for inter-layer communication
+        /**
+         * @brief Checks whether reactive rendering owes a frame.
+         * @param sinceLastFrame Seconds since the previous frame started
+         * @return True if a frame was requested, an animation window is open or a task is due
+         */
+        bool IsFrameRequested(double sinceLastFrame);
+
+        /**
+         * @brief Blocks on window events until a frame is due or the idle timeout passes.
+         * @param lastFrameTime Start of the previous frame
+         * @param idleTime Accumulates the time spent blocked
+         * @return True if a frame should run now
+         */
+        bool WaitForFrame(std::chrono::steady_clock::time_point lastFrameTime,
+            std::chrono::steady_clock::duration &idleTime);
+
+        /**
+         * @brief Runs the fixed steps and the layer updates of one frame.
+         * @param timestep Seconds passed to OnUpdate()
+         */
+        void SimulateFrame(float timestep);
+
+        /**
+         * @brief Renders the layers from their published snapshots and presents the frame.
+         */
+        void RenderFrame();
+
+        /**
+         * @brief Makes the state simulated since the last publish visible to OnRender().
+         */
+        void PublishRenderSnapshots();
+
+        /**
+         * @brief Body of the simulation thread in pipelined mode: simulates each frame handed to it.
+         */
+        void SimulationLoop();
+
+        /**
+         * @brief Lets the simulation thread finish any frame handed to it and joins it, if it is running.
+         */
+        void StopSimulationThread();
+
+        ApplicationSpecification specification;                       ///< Application configuration
+        ThreadPool threadPool;                                        ///< Worker pool (outlives the event bus)
+        EventBus eventBus;                                            ///< Event bus (outlives layer subscriptions)
+        std::unique_ptr<StaticEventBusBase> staticEventBus;           ///< Optional typed bus in front of eventBus
+        std::size_t staticEventBusType = 0;                           ///< Dense type index of the installed bus
+        TaskScheduler taskScheduler;                                  ///< Coroutine tasks (awaiters hold bus tokens)
+        std::vector<std::shared_ptr<EventChannelBase>> eventChannels; ///< Cross-thread channels drained every frame
+        std::vector<std::unique_ptr<EventStreamBase>> eventStreams;   ///< Pull streams indexed by dense type index
+        std::vector<EventStreamBase *> eventStreamOrder;              ///< Pull streams in creation order
+        std::vector<std::unique_ptr<Layer>> layerStack;               ///< Stack of application layers
+        LayerUpdateGraph layerUpdateGraph;                            ///< Dependencies between layer updates
+        bool layerGraphDirty = true;                                  ///< Layer stack changed since the last build
+        EventRecorder *eventRecorder = nullptr;                       ///< Optional recorder advanced every frame
+        std::optional<FixedTimestep> fixedTimestep;                   ///< Fixed-step accumulator, if enabled
+        FrameLimiter frameLimiter;                                    ///< Frame-rate cap and pacing statistics
+        std::atomic<bool> frameRequested = true;                      ///< Reactive mode owes a frame
+        std::chrono::steady_clock::time_point continuousUntil;        ///< Reactive mode runs every frame until then
+        std::unique_ptr<Window> window;                               ///< Main application window, null if headless
+        std::uint64_t frameCount = 0;                                 ///< Frames completed by Run()
+        std::chrono::steady_clock::time_point creationTime;           ///< Origin of GetTime()
+        std::thread simulationThread;                                 ///< Runs SimulateFrame() in pipelined mode
+        std::binary_semaphore simulationStart{ 0 };                   ///< Hands a frame to the simulation thread
+        std::binary_semaphore simulationDone{ 0 };                    ///< Signals the handed frame is simulated
+        std::exception_ptr simulationError;                           ///< Exception thrown on the simulation thread
+        float simulationTimestep = 0.0f;                              ///< Timestep of the frame handed over
+        float renderInterpolationAlpha = 0.0f;                        ///< Fixed-step alpha of the published frame
+        bool simulationStopping = false;                              ///< Ends SimulationLoop() at the next handover
+        bool simulationFrameInFlight = false;                         ///< A frame was handed over and not yet awaited
+        bool isRunning = false;                                       ///< Flag indicating if the application is running
+    };
+
+    /**
+     * @brief Makes an application current on the calling thread for a scope.
+     * @note Jobs on the thread pool that call Application::Get() open one with the application they work for.
+     *       The previously current application, if any, is restored when the scope ends.
+     */
+    class CurrentApplicationScope
+    {
+    public:
+        /**
+         * @brief Makes an application current.
+         * @param application Application to make current, may be null
+         */
+        explicit CurrentApplicationScope(Application *application);
+
+        /**
+         * @brief Restores the previously current application.
+         */
+        ~CurrentApplicationScope();
+
+        CurrentApplicationScope(const CurrentApplicationScope &) = delete;
+        CurrentApplicationScope &operator=(const CurrentApplicationScope &) = delete;
+
+    private:
+        Application *previous; ///< Application current before the scope
     };
 } // namespace Kappa
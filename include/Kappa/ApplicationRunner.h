@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Application.h"
+#include "FrameLimiter.h"
+#include "ThreadPool.h"
+
+namespace Kappa
+{
+    /**
+     * @brief Outcome of one application instance run by ApplicationRunner.
+     */
+    struct ApplicationRunResult
+    {
+        std::size_t index = 0;        ///< Instance index passed to the factory
+        bool succeeded = false;       ///< False if the factory or the run threw
+        std::string error;            ///< Exception message when the run failed
+        std::uint64_t frameCount = 0; ///< Frames completed by Run()
+        double seconds = 0.0;         ///< Wall-clock duration of Run()
+        FramePacingStats pacing;      ///< Frame pacing over the instance's most recent frames
+    };
+
+    /**
+     * @brief Runs many independent headless applications in parallel, one per worker thread at a time.
+     * @note Each instance is created by the factory on the worker that runs it, so Application::Get() inside
+     *       its layers refers to that instance. Instances must be headless and must stop on their own, e.g.
+     *       through ApplicationSpecification::maxFrames or Stop(). Instances left at the default
+     *       `workerThreadCount` (AutoWorkerCount) get no pool workers and run their jobs inline, since the
+     *       runner already keeps every core busy; an explicit count is honoured.
+     */
+    class ApplicationRunner
+    {
+    public:
+        /**
+         * @brief Creates an application for an instance index.
+         */
+        using Factory = std::function<std::unique_ptr<Application>(std::size_t index)>;
+
+        /**
+         * @brief Starts the runner's workers.
+         * @param threadCount Instances run at once (at least 1)
+         */
+        explicit ApplicationRunner(std::size_t threadCount = std::thread::hardware_concurrency());
+
+        /**
+         * @brief Creates and runs `instanceCount` applications across the workers and waits for all of them.
+         * @param instanceCount Number of instances
+         * @param factory Called once per instance on the worker thread that runs it
+         * @return One result per instance, in index order
+         * @note Exceptions from the factory or from the run are caught and reported in the result.
+         */
+        [[nodiscard]] std::vector<ApplicationRunResult> Run(std::size_t instanceCount, const Factory &factory);
+
+        /**
+         * @brief Returns the number of instances that run at once.
+         * @return Worker thread count
+         */
+        [[nodiscard]] std::size_t GetThreadCount() const
+        {
+            return pool.GetWorkerCount();
+        }
+
+        /**
+         * @brief Checks whether the calling thread is creating or running an instance for a runner.
+         * @return True inside the factory and the instance's Run()
+         */
+        [[nodiscard]] static bool IsRunningInstance();
+
+    private:
+        ThreadPool pool; ///< Workers running one instance each at a time
+    };
+} // namespace Kappa
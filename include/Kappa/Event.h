@@ -1,5 +1,7 @@
 #pragma once
 
+#include <type_traits>
+
 namespace Kappa
 {
     /**
@@ -10,4 +12,48 @@ namespace Kappa
     public:
         virtual ~Event() = default;
     };
+
+    /**
+     * @brief Base for events that should also reach subscribers of a parent event type.
+     * @tparam TSelf Event type being declared
+     * @tparam TParent Parent event type (Event or another DerivedEvent)
+     * @note `class KeyPressedEvent : public DerivedEvent<KeyPressedEvent, InputEvent>` makes InputEvent
+     *       subscribers receive KeyPressedEvent too. The chain is resolved at compile time, without RTTI.
+     */
+    template<typename TSelf, typename TParent = Event>
+        requires std::is_base_of_v<Event, TParent>
+    class DerivedEvent : public TParent
+    {
+    public:
+        using TParent::TParent;
+
+        using ParentEvent = TParent; ///< Next event type up the dispatch chain
+        using SelfEvent = TSelf;     ///< Type that declared ParentEvent
+    };
+
+    namespace Detail
+    {
+        /**
+         * @brief Resolves the parent event type that also receives an event, or void at the end of the chain.
+         * @tparam TEvent Event type
+         * @note A class deriving from a DerivedEvent without declaring its own continues from the nearest
+         *       declared ancestor. Event itself ends the chain and is not a catch-all subscription.
+         */
+        template<typename TEvent> struct ParentEventOf
+        {
+            using Type = void;
+        };
+
+        template<typename TEvent>
+            requires requires { typename TEvent::SelfEvent; }
+        struct ParentEventOf<TEvent>
+        {
+            using Declared = std::conditional_t<std::is_same_v<typename TEvent::SelfEvent, TEvent>,
+                typename TEvent::ParentEvent,
+                typename TEvent::SelfEvent>;
+            using Type = std::conditional_t<std::is_same_v<Declared, Event>, void, Declared>;
+        };
+
+        template<typename TEvent> using ParentEvent = typename ParentEventOf<TEvent>::Type;
+    } // namespace Detail
 } // namespace Kappa
@@ -1,79 +1,1490 @@
 #pragma once
 
 #include "Event.h"
+#include "EventStats.h"
+#include "InplaceFunction.h"
+#include "Layer.h"
+#include "SnapshotPtr.h"
+#include "Subscription.h"
+#include "Task.h"
+#include "ThreadPool.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <typeindex>
-#include <unordered_map>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace Kappa
 {
+    namespace Detail
+    {
+        /**
+         * @brief Hands out the next dense event type index.
+         * @return Unique index shared by every EventBus in the process
+         */
+        inline std::size_t NextEventTypeIndex()
+        {
+            static std::atomic<std::size_t> counter{ 0 };
+            return counter.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Returns the dense index assigned to an event type.
+         * @tparam TEvent Event type
+         * @return Index usable for direct table lookup (no hashing, no RTTI)
+         */
+        template<typename TEvent> std::size_t EventTypeIndex()
+        {
+            static const std::size_t index = NextEventTypeIndex();
+            return index;
+        }
+
+        /**
+         * @brief Scrambles a subscription key so sequential entity IDs spread over the keyed buckets.
+         * @param key Key to mix
+         * @return Mixed value (splitmix64 finalizer)
+         */
+        constexpr std::uint64_t MixKey(std::uint64_t key)
+        {
+            key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+            return key ^ (key >> 31);
+        }
+
+        /**
+         * @brief Key of the publish being dispatched on this thread, null for unkeyed publishes.
+         */
+        constinit inline thread_local const std::uint64_t *currentPublishKey = nullptr;
+
+        /**
+         * @brief Sets the key reported by EventBus::GetPublishKey() for the duration of a publish.
+         * @note Restores the previous key, so a handler publishing another event doesn't clobber its own.
+         */
+        class PublishKeyScope
+        {
+        public:
+            explicit PublishKeyScope(const std::uint64_t *key) : previous(currentPublishKey)
+            {
+                currentPublishKey = key;
+            }
+
+            ~PublishKeyScope()
+            {
+                currentPublishKey = previous;
+            }
+
+            PublishKeyScope(const PublishKeyScope &) = delete;
+            PublishKeyScope &operator=(const PublishKeyScope &) = delete;
+
+        private:
+            const std::uint64_t *previous; ///< Key of the enclosing publish
+        };
+    } // namespace Detail
+
+    template<typename TEvent> class NextEventAwaiter;
+
     /**
      * @brief Event bus for publish-subscribe communication between layers.
+     * @note Handlers are stored already typed per event, and each event type owns an immutable
+     *       handler snapshot. Publishing takes no mutex and, after a thread's first publish registers its
+     *       epoch record, never allocates: it pins that record, loads the channel table and the raw
+     *       snapshot pointer with single atomic loads, then makes a single indirect call per handler.
+     *       Nothing shared is written, so concurrent publishers of one type don't contend on a cache line. Subscribe and Clear serialize on a writer mutex and pay the
+     *       copy cost instead (read-copy-update), so handlers may subscribe from inside a callback; the
+     *       snapshots they replace are retired and freed once no publisher pinned before the replacement
+     *       is still running.
+     *       Callbacks live in InplaceFunction storage; callables larger than HandlerCapacity don't
+     *       compile, so wrap oversized state in a std::function or shared pointer to opt into the heap.
+     *       Snapshots are kept sorted by priority, so a handler returning true (handled) stops
+     *       propagation without any per-publish sorting.
      */
-    class EventBus
+    class EventBus : public SubscriptionHost
     {
     public:
+        /**
+         * @brief Inline storage available to each handler callable, in bytes.
+         */
+        static constexpr std::size_t HandlerCapacity = 8 * sizeof(void *);
+
+        EventBus() = default;
+
+        EventBus(const EventBus &) = delete;
+        EventBus &operator=(const EventBus &) = delete;
+
         /**
          * @brief Subscribes to events of a specific type.
          * @tparam TEvent Event type (must derive from Event)
+         * @tparam TCallback Callable invocable with `const TEvent &`, returning void or bool
+         * @param callback Callback function; returning true marks the event handled and stops dispatch
+         * @param priority Higher priorities run first; equal priorities run in subscription order
+         * @return Token that removes the handler when destroyed
+         * @note Stored behind a batch adapter, so PublishBatch calls it once per event in a single loop.
+         */
+        template<typename TEvent, typename TCallback>
+            requires std::is_base_of_v<Event, TEvent> && std::is_invocable_v<std::decay_t<TCallback> &, const TEvent &>
+        [[nodiscard]] Subscription Subscribe(TCallback &&callback, int priority = 0)
+        {
+            constexpr bool consumes = CanMarkHandled<TEvent, TCallback>();
+            const auto name = Detail::TypeName<std::decay_t<TCallback>>();
+            auto adapter = MakeEventAdapter<TEvent>(std::forward<TCallback>(callback));
+            return AddHandler<TEvent>(std::move(adapter), priority, consumes, false, name);
+        }
+
+        /**
+         * @brief Subscribes to events of a specific type published under one key.
+         * @tparam TEvent Event type (must derive from Event)
+         * @tparam TCallback Callable invocable with `const TEvent &`, returning void or bool
+         * @param key Entity or topic ID; only Publish(key, event) with the same key reaches the handler
+         * @param callback Callback function; returning true marks the event handled and stops dispatch
+         * @param priority Higher priorities run first; on equal priority keyed handlers run before wildcards
+         * @return Token that removes the handler when destroyed
+         * @note Keyed handlers live in a hashed table per event type, so a publish only touches the handlers
+         *       of its key (plus the wildcard handlers registered without a key), however many keys exist.
+         */
+        template<typename TEvent, typename TCallback>
+            requires std::is_base_of_v<Event, TEvent> && std::is_invocable_v<std::decay_t<TCallback> &, const TEvent &>
+        [[nodiscard]] Subscription Subscribe(std::uint64_t key, TCallback &&callback, int priority = 0)
+        {
+            constexpr bool consumes = CanMarkHandled<TEvent, TCallback>();
+            const auto name = Detail::TypeName<std::decay_t<TCallback>>();
+            auto adapter = MakeEventAdapter<TEvent>(std::forward<TCallback>(callback));
+            return AddKeyedHandler<TEvent>(key, std::move(adapter), priority, consumes, name);
+        }
+
+        /**
+         * @brief Subscribes to events of a specific type for the lifetime of a layer.
+         * @tparam TEvent Event type (must derive from Event)
+         * @tparam TCallback Callable invocable with `const TEvent &`, returning void or bool
+         * @param owner Layer that keeps the subscription; it is removed when the layer is destroyed
+         * @param callback Callback function; returning true marks the event handled and stops dispatch
+         * @param priority Higher priorities run first; equal priorities run in subscription order
+         * @note The bus must outlive the layer.
+         */
+        template<typename TEvent, typename TCallback>
+            requires std::is_base_of_v<Event, TEvent> && std::is_invocable_v<std::decay_t<TCallback> &, const TEvent &>
+        void Subscribe(Layer &owner, TCallback &&callback, int priority = 0)
+        {
+            owner.subscriptions.push_back(Subscribe<TEvent>(std::forward<TCallback>(callback), priority));
+        }
+
+        /**
+         * @brief Subscribes to events of a specific type published under one key, for the lifetime of a layer.
+         * @tparam TEvent Event type (must derive from Event)
+         * @tparam TCallback Callable invocable with `const TEvent &`, returning void or bool
+         * @param owner Layer that keeps the subscription; it is removed when the layer is destroyed
+         * @param key Entity or topic ID
+         * @param callback Callback function; returning true marks the event handled and stops dispatch
+         * @param priority Higher priorities run first
+         * @note The bus must outlive the layer.
+         */
+        template<typename TEvent, typename TCallback>
+            requires std::is_base_of_v<Event, TEvent> && std::is_invocable_v<std::decay_t<TCallback> &, const TEvent &>
+        void Subscribe(Layer &owner, std::uint64_t key, TCallback &&callback, int priority = 0)
+        {
+            owner.subscriptions.push_back(Subscribe<TEvent>(key, std::forward<TCallback>(callback), priority));
+        }
+
+        /**
+         * @brief Subscribes to events of a specific type, receiving whole batches at once.
+         * @tparam TEvent Event type (must derive from Event)
+         * @tparam TCallback Callable invocable with `std::span<const TEvent>`
          * @param callback Callback function
+         * @param priority Higher priorities run first; equal priorities run in subscription order
+         * @return Token that removes the handler when destroyed
+         * @note Publish delivers a span of one event. Batch handlers observe and can't mark events handled.
          */
-        template<typename TEvent>
+        template<typename TEvent, typename TCallback>
+            requires std::is_base_of_v<Event, TEvent>
+                     && std::is_invocable_v<std::decay_t<TCallback> &, std::span<const TEvent>>
+        [[nodiscard]] Subscription SubscribeBatch(TCallback &&callback, int priority = 0)
+        {
+            auto adapter = [callback = std::forward<TCallback>(callback)](std::span<const TEvent> events) mutable {
+                std::invoke(callback, events);
+                return false;
+            };
+            const auto name = Detail::TypeName<std::decay_t<TCallback>>();
+            return AddHandler<TEvent>(BatchCallback<TEvent>(std::move(adapter)), priority, false, false, name);
+        }
+
+        /**
+         * @brief Subscribes to batches of a specific event type for the lifetime of a layer.
+         * @tparam TEvent Event type (must derive from Event)
+         * @tparam TCallback Callable invocable with `std::span<const TEvent>`
+         * @param owner Layer that keeps the subscription; it is removed when the layer is destroyed
+         * @param callback Callback function
+         * @param priority Higher priorities run first; equal priorities run in subscription order
+         * @note The bus must outlive the layer.
+         */
+        template<typename TEvent, typename TCallback>
             requires std::is_base_of_v<Event, TEvent>
-        void Subscribe(std::function<void(const TEvent &)> callback)
+                     && std::is_invocable_v<std::decay_t<TCallback> &, std::span<const TEvent>>
+        void SubscribeBatch(Layer &owner, TCallback &&callback, int priority = 0)
+        {
+            owner.subscriptions.push_back(SubscribeBatch<TEvent>(std::forward<TCallback>(callback), priority));
+        }
+
+        /**
+         * @brief Subscribes a handler that may run concurrently with other concurrent-safe handlers.
+         * @tparam TEvent Event type (must derive from Event)
+         * @tparam TCallback Callable invocable with `const TEvent &` and returning void
+         * @param callback Callback function; must be safe to call from any thread
+         * @return Token that removes the handler when destroyed
+         * @note After the sequential handlers of the type ran without handling the event, concurrent handlers
+         *       are split across the thread pool set with SetThreadPool() and joined before Publish returns.
+         *       Without a pool they run one after another on the publishing thread.
+         */
+        template<typename TEvent, typename TCallback>
+            requires std::is_base_of_v<Event, TEvent> && std::is_invocable_v<std::decay_t<TCallback> &, const TEvent &>
+        [[nodiscard]] Subscription SubscribeConcurrent(TCallback &&callback)
         {
-            std::lock_guard<std::mutex> lock(subscribersMutex);
-            const auto typeIndex = std::type_index(typeid(TEvent));
-            auto wrapper = [callback](const Event &event) {
-                if (const auto *specEvent = dynamic_cast<const TEvent *>(&event))
+            static_assert(std::is_void_v<std::invoke_result_t<std::decay_t<TCallback> &, const TEvent &>>,
+                "Concurrent handlers run side by side and can't mark events handled");
+
+            auto adapter = [callback = std::forward<TCallback>(callback)](std::span<const TEvent> events) mutable {
+                for (const auto &event : events)
                 {
-                    callback(*specEvent);
+                    std::invoke(callback, event);
                 }
+                return false;
             };
-            subscribers[typeIndex].push_back(wrapper);
+            const auto name = Detail::TypeName<std::decay_t<TCallback>>();
+            return AddHandler<TEvent>(BatchCallback<TEvent>(std::move(adapter)), 0, false, true, name);
+        }
+
+        /**
+         * @brief Subscribes a concurrent-safe handler for the lifetime of a layer.
+         * @tparam TEvent Event type (must derive from Event)
+         * @tparam TCallback Callable invocable with `const TEvent &` and returning void
+         * @param owner Layer that keeps the subscription; it is removed when the layer is destroyed
+         * @param callback Callback function; must be safe to call from any thread
+         * @note The bus must outlive the layer.
+         */
+        template<typename TEvent, typename TCallback>
+            requires std::is_base_of_v<Event, TEvent> && std::is_invocable_v<std::decay_t<TCallback> &, const TEvent &>
+        void SubscribeConcurrent(Layer &owner, TCallback &&callback)
+        {
+            owner.subscriptions.push_back(SubscribeConcurrent<TEvent>(std::forward<TCallback>(callback)));
+        }
+
+        /**
+         * @brief Suspends the awaiting task until the next event of a type is published.
+         * @tparam TEvent Event type (must derive from Event and be copyable)
+         * @return Awaiter producing a copy of the event
+         * @note Only valid inside a task spawned on a TaskScheduler. The awaiter observes at the default
+         *       priority while the task waits; the task resumes in the scheduler's next update, so events
+         *       published in the meantime are not seen by it.
+         */
+        template<typename TEvent>
+            requires std::is_base_of_v<Event, TEvent> && std::is_copy_constructible_v<TEvent>
+        [[nodiscard]] NextEventAwaiter<TEvent> Next()
+        {
+            return NextEventAwaiter<TEvent>(*this);
+        }
+
+        /**
+         * @brief Sets the pool that runs concurrent handlers.
+         * @param pool Thread pool, or nullptr to run them on the publishing thread; must outlive its use
+         * @note Application hands its own pool to its bus.
+         */
+        void SetThreadPool(ThreadPool *pool)
+        {
+            threadPool.store(pool, std::memory_order_release);
+        }
+
+        /**
+         * @brief Publishes an event to subscribers in priority order until one handles it.
+         * @tparam TEvent Event type (must derive from Event)
+         * @param event Event to publish
+         * @return True if a handler marked the event handled
+         * @note Takes no mutex, so it never waits for a subscriber copying a snapshot. Subscribers of the exact
+         *       type run first, then subscribers of each parent declared through DerivedEvent, most derived first.
+         */
+        template<typename TEvent>
+            requires std::is_base_of_v<Event, TEvent>
+        bool Publish(const TEvent &event)
+        {
+            RecordPublishes<TEvent>(1);
+            Detail::PublishKeyScope keyScope(nullptr);
+            Detail::ReadGuard guard;
+            return DispatchChain<TEvent>(event);
         }
 
         /**
-         * @brief Publishes an event to all subscribers.
+         * @brief Publishes an event under a key to that key's handlers and to the wildcard handlers.
          * @tparam TEvent Event type (must derive from Event)
+         * @param key Entity or topic ID
          * @param event Event to publish
+         * @return True if a handler marked the event handled
+         * @note Costs one hashed bucket lookup per type in the DerivedEvent chain; handlers of other keys are
+         *       never visited. Handlers subscribed under a key don't receive events published without one.
+         */
+        template<typename TEvent>
+            requires std::is_base_of_v<Event, TEvent>
+        bool Publish(std::uint64_t key, const TEvent &event)
+        {
+            RecordPublishes<TEvent>(1);
+            Detail::PublishKeyScope keyScope(&key);
+            Detail::ReadGuard guard;
+            return DispatchKeyedChain<TEvent>(key, event);
+        }
+
+        /**
+         * @brief Returns the key of the publish whose handlers are running on the calling thread.
+         * @return Key passed to Publish(key, event), or nothing for events published without a key
+         * @note Lets wildcard handlers such as EventRecorder tell keyed events apart. Concurrent handlers
+         *       that run on pool threads see nothing.
+         */
+        [[nodiscard]] static std::optional<std::uint64_t> GetPublishKey()
+        {
+            if (const auto *key = Detail::currentPublishKey)
+            {
+                return *key;
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Publishes a contiguous batch of events of one type.
+         * @tparam TEvent Event type (must derive from Event)
+         * @param events Events to publish
+         * @note Loads the handler snapshot once. Unless a subscriber can mark events handled, each handler
+         *       is called once with the whole span, so it sees every event before the next handler runs.
+         *       Otherwise events are dispatched one at a time so handling can stop propagation. Parent type
+         *       subscribers always receive the events one at a time.
          */
         template<typename TEvent>
             requires std::is_base_of_v<Event, TEvent>
-        void Publish(const TEvent &event)
+        void PublishBatch(std::span<const TEvent> events)
         {
-            std::vector<EventCallback> handlers;
+            if (events.empty())
+            {
+                return;
+            }
+
+            RecordPublishes<TEvent>(events.size());
+            Detail::PublishKeyScope keyScope(nullptr);
+            Detail::ReadGuard guard;
+            const auto *channel = FindChannel<TEvent>();
+            const auto *handlers = channel ? channel->handlers.Load() : nullptr;
+            if (handlers && !handlers->consumes)
             {
-                std::lock_guard<std::mutex> lock(subscribersMutex);
-                const auto typeIndex = std::type_index(typeid(TEvent));
-                if (const auto it = subscribers.find(typeIndex); it != subscribers.end())
+                Dispatch(*handlers, events);
+                if constexpr (!std::is_void_v<Detail::ParentEvent<TEvent>>)
                 {
-                    handlers = it->second;
+                    for (const auto &event : events)
+                    {
+                        DispatchChain<Detail::ParentEvent<TEvent>>(event);
+                    }
                 }
+                return;
+            }
+
+            for (const auto &event : events)
+            {
+                DispatchChain<TEvent>(event);
+            }
+        }
+
+        /**
+         * @brief Queues an event for deferred delivery by DispatchQueued().
+         * @tparam TEvent Event type (must derive from Event)
+         * @tparam Args Constructor argument types
+         * @param args Arguments forwarded to the event constructor
+         * @note Events are stored by value in a contiguous per-type queue whose memory is reused across
+         *       frames. Not thread-safe: enqueue from the thread that calls DispatchQueued().
+         */
+        template<typename TEvent, typename... Args>
+            requires std::is_base_of_v<Event, TEvent> && std::is_constructible_v<TEvent, Args...>
+        void Enqueue(Args &&...args)
+        {
+            GetOrCreateQueue<TEvent>().pending.emplace_back(std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Stores the latest value of a high-frequency event for delivery by DispatchQueued().
+         * @tparam TEvent Event type (must derive from Event)
+         * @param event Event; replaces any value coalesced since the last dispatch
+         * @note Subscribers see one event per frame however often this is called, which suits mouse moves,
+         *       resizes and position updates. Same threading rules as Enqueue(). Delivered like
+         *       Publish(event), so handlers subscribed under a key don't receive it.
+         */
+        template<typename TEvent>
+            requires std::is_base_of_v<Event, TEvent> && std::is_copy_assignable_v<TEvent>
+        void Coalesce(const TEvent &event)
+        {
+            GetOrCreateQueue<TEvent>().latest = event;
+        }
+
+        /**
+         * @brief Stores the latest value of a high-frequency event per key for delivery by DispatchQueued().
+         * @tparam TEvent Event type (must derive from Event)
+         * @param key Entity or topic ID; each key keeps its own latest value
+         * @param event Event; replaces the value coalesced under the same key since the last dispatch
+         * @note Each value is delivered like Publish(key, event): to the handlers subscribed under that key and
+         *       to the wildcard handlers. Keys are delivered in the order they were first coalesced during the
+         *       frame, after the events of the same type queued with Enqueue() or coalesced without a key.
+         *       The slots reuse their memory across frames.
+         */
+        template<typename TEvent>
+            requires std::is_base_of_v<Event, TEvent> && std::is_copy_assignable_v<TEvent>
+        void Coalesce(std::uint64_t key, const TEvent &event)
+        {
+            GetOrCreateQueue<TEvent>().CoalesceKeyed(key, event);
+        }
+
+        /**
+         * @brief Delivers every event queued before this call, one event type at a time.
+         * @note Events queued by handlers during dispatch are delivered by the next call.
+         *       Application::Run calls this once per frame, after the layer update pass.
+         */
+        void DispatchQueued()
+        {
+            // Handlers may create queues for new types, growing queueOrder; those have nothing swapped in yet
+            const auto count = queueOrder.size();
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                queueOrder[index]->Swap();
             }
 
-            for (const auto &callback : handlers)
+            for (std::size_t index = 0; index < count; ++index)
             {
-                callback(event);
+                queueOrder[index]->Dispatch(*this);
             }
         }
 
         /**
          * @brief Clears all subscribers.
+         * @note Publishes already in flight finish with the snapshot they loaded, which is retired until
+         *       they are done. Outstanding Subscription tokens become stale and are ignored when destroyed.
          */
         void Clear()
         {
-            std::lock_guard<std::mutex> lock(subscribersMutex);
-            subscribers.clear();
+            std::lock_guard<std::mutex> lock(writerMutex);
+            for (const auto &channel : channelStorage)
+            {
+                channel->Reset();
+            }
+
+            for (std::uint32_t slot = 0; slot < slots.size(); ++slot)
+            {
+                if (slots[slot].channel)
+                {
+                    FreeSlot(slot);
+                }
+            }
+        }
+
+        /**
+         * @brief Whether this build records event statistics.
+         * @note Enabled by defining KAPPA_ENABLE_EVENT_STATS (CMake option ENABLE_EVENT_STATS). When disabled,
+         *       no counters exist and the statistics functions below do nothing.
+         */
+#if defined(KAPPA_ENABLE_EVENT_STATS)
+        static constexpr bool IsInstrumented = true;
+#else
+        static constexpr bool IsInstrumented = false;
+#endif
+
+        /**
+         * @brief Returns a snapshot of the instrumentation counters.
+         * @return Statistics per event type seen by the bus, empty when instrumentation is compiled out
+         * @note Handler timings cover current subscribers only; publish counts survive unsubscribing.
+         */
+        [[nodiscard]] EventBusStats GetStats() const
+        {
+            EventBusStats stats;
+#if defined(KAPPA_ENABLE_EVENT_STATS)
+            std::lock_guard<std::mutex> lock(writerMutex);
+            stats.frameCount = statsFrameCount;
+            stats.eventTypes.reserve(channelStorage.size());
+            for (const auto &channel : channelStorage)
+            {
+                stats.eventTypes.push_back(channel->CollectStats());
+            }
+#endif
+            return stats;
+        }
+
+        /**
+         * @brief Closes an instrumentation frame, rolling per-frame publish counts.
+         * @note Application::Run calls this once per frame.
+         */
+        void EndStatsFrame()
+        {
+#if defined(KAPPA_ENABLE_EVENT_STATS)
+            std::lock_guard<std::mutex> lock(writerMutex);
+            for (const auto &channel : channelStorage)
+            {
+                channel->counters.EndFrame();
+            }
+            statsFrameCount++;
+#endif
+        }
+
+        /**
+         * @brief Zeroes every instrumentation counter.
+         */
+        void ResetStats()
+        {
+#if defined(KAPPA_ENABLE_EVENT_STATS)
+            std::lock_guard<std::mutex> lock(writerMutex);
+            for (const auto &channel : channelStorage)
+            {
+                channel->ResetStats();
+            }
+            statsFrameCount = 0;
+#endif
         }
 
     private:
-        using EventCallback = std::function<void(const Event &)>;
-        std::unordered_map<std::type_index, std::vector<EventCallback>> subscribers;
-        mutable std::mutex subscribersMutex;
+        /**
+         * @brief Type-erased deferred event queue.
+         */
+        struct QueueBase
+        {
+            virtual ~QueueBase() = default;
+
+            /**
+             * @brief Moves pending events into the dispatch buffer.
+             */
+            virtual void Swap() = 0;
+
+            /**
+             * @brief Publishes the dispatch buffer and empties it, keeping its capacity.
+             * @param bus Bus to publish to
+             */
+            virtual void Dispatch(EventBus &bus) = 0;
+        };
+
+        /**
+         * @brief Double-buffered contiguous queue and coalescing slots for a single event type.
+         * @tparam TEvent Event type
+         */
+        template<typename TEvent> struct Queue final : QueueBase
+        {
+            using KeyedEvent = std::pair<std::uint64_t, TEvent>; ///< Coalesced value and its key
+
+            void Swap() override
+            {
+                pending.swap(dispatching);
+                latest.swap(dispatchingLatest);
+                if (!coalesced.empty())
+                {
+                    std::fill(coalescedSlots.begin(), coalescedSlots.end(), 0);
+                }
+                coalesced.swap(dispatchingCoalesced);
+            }
+
+            void Dispatch(EventBus &bus) override
+            {
+                bus.PublishBatch(std::span<const TEvent>(dispatching));
+                dispatching.clear();
+                if (dispatchingLatest)
+                {
+                    bus.Publish(*dispatchingLatest);
+                    dispatchingLatest.reset();
+                }
+                for (const auto &[key, event] : dispatchingCoalesced)
+                {
+                    bus.Publish(key, event);
+                }
+                dispatchingCoalesced.clear();
+            }
+
+            /**
+             * @brief Stores the latest value of a key, appending the key on its first use this frame.
+             * @note Linear probing over a power-of-two table kept at most half full. The table is zeroed rather
+             *       than freed by Swap(), so no allocation happens once it has grown to the busiest frame.
+             */
+            void CoalesceKeyed(std::uint64_t key, const TEvent &event)
+            {
+                if (2 * (coalesced.size() + 1) > coalescedSlots.size())
+                {
+                    GrowCoalescedSlots();
+                }
+
+                const auto mask = coalescedSlots.size() - 1;
+                for (auto index = Detail::MixKey(key) & mask;; index = (index + 1) & mask)
+                {
+                    const auto position = coalescedSlots[index];
+                    if (position == 0)
+                    {
+                        coalesced.emplace_back(key, event);
+                        coalescedSlots[index] = static_cast<std::uint32_t>(coalesced.size());
+                        return;
+                    }
+                    if (coalesced[position - 1].first == key)
+                    {
+                        coalesced[position - 1].second = event;
+                        return;
+                    }
+                }
+            }
+
+            /**
+             * @brief Doubles the slot table and re-inserts the keys coalesced this frame.
+             */
+            void GrowCoalescedSlots()
+            {
+                coalescedSlots.assign(std::max<std::size_t>(16, 2 * coalescedSlots.size()), 0);
+                const auto mask = coalescedSlots.size() - 1;
+                for (std::size_t position = 0; position < coalesced.size(); ++position)
+                {
+                    auto index = Detail::MixKey(coalesced[position].first) & mask;
+                    while (coalescedSlots[index] != 0)
+                    {
+                        index = (index + 1) & mask;
+                    }
+                    coalescedSlots[index] = static_cast<std::uint32_t>(position + 1);
+                }
+            }
+
+            std::vector<TEvent> pending;                  ///< Events enqueued since the last dispatch
+            std::vector<TEvent> dispatching;              ///< Events delivered by the current dispatch
+            std::optional<TEvent> latest;                 ///< Latest value coalesced without a key
+            std::optional<TEvent> dispatchingLatest;      ///< Unkeyed value being delivered
+            std::vector<KeyedEvent> coalesced;            ///< Latest value per key, first-seen order
+            std::vector<KeyedEvent> dispatchingCoalesced; ///< Keyed values being delivered
+            std::vector<std::uint32_t> coalescedSlots;    ///< Open-addressed key table; position in coalesced + 1
+        };
+
+        template<typename TEvent> Queue<TEvent> &GetOrCreateQueue()
+        {
+            const auto index = Detail::EventTypeIndex<TEvent>();
+            if (index >= queues.size())
+            {
+                queues.resize(index + 1);
+            }
+
+            if (!queues[index])
+            {
+                queues[index] = std::make_unique<Queue<TEvent>>();
+                queueOrder.push_back(queues[index].get());
+            }
+
+            return static_cast<Queue<TEvent> &>(*queues[index]);
+        }
+
+        struct ChannelBase;
+
+        /**
+         * @brief Generational slot map entry locating a live subscription.
+         */
+        struct SubscriptionSlot
+        {
+            ChannelBase *channel = nullptr; ///< Channel holding the handler, null when the slot is free
+            std::size_t denseIndex = 0;     ///< Position of the handler in the channel snapshot
+            std::uint64_t key = 0;          ///< Subscription key of a keyed handler
+            std::uint32_t generation = 0;   ///< Bumped on release so stale tokens are ignored
+            bool keyed = false;             ///< Handler lives in the keyed table rather than the snapshot
+        };
+
+        template<typename TEvent>
+        using BatchCallback = InplaceFunction<bool(std::span<const TEvent>), HandlerCapacity>;
+
+        /**
+         * @brief Immutable handler node shared by every snapshot that contains it.
+         * @tparam TEvent Event type
+         * @note Callbacks are move-only, so snapshots copy node pointers rather than callables.
+         */
+        template<typename TEvent> struct Handler
+        {
+            Handler(BatchCallback<TEvent> &&callback,
+                std::uint32_t slot,
+                int priority,
+                bool consumes,
+                [[maybe_unused]] std::string_view name)
+                : callback(std::move(callback)), slot(slot), priority(priority), consumes(consumes)
+            {
+#if defined(KAPPA_ENABLE_EVENT_STATS)
+                this->name = name;
+#endif
+            }
+
+            BatchCallback<TEvent> callback; ///< User callback behind an adapter; returns true when handled
+            std::uint32_t slot;             ///< Back-reference into the slot map
+            int priority;                   ///< Dispatch priority, fixed at subscribe time
+            bool consumes;                  ///< Whether the callback can mark events handled
+#if defined(KAPPA_ENABLE_EVENT_STATS)
+            std::string_view name;                      ///< Callable type name
+            mutable Detail::HandlerCounters counters{}; ///< Invocation timings
+#endif
+        };
+
+        /**
+         * @brief Immutable handler snapshot, sorted by descending priority.
+         * @tparam TEvent Event type
+         */
+        template<typename TEvent> struct HandlerList
+        {
+            using HandlerPtr = std::shared_ptr<const Handler<TEvent>>;
+
+            std::vector<HandlerPtr> handlers;           ///< Sequential handlers in dispatch order
+            std::vector<HandlerPtr> concurrentHandlers; ///< Concurrent-safe handlers, fanned out after them
+            bool consumes = false;                      ///< Any handler can mark events handled
+        };
+
+        /**
+         * @brief Immutable keyed handlers of one hash bucket, sorted by descending priority.
+         * @tparam TEvent Event type
+         * @note Several keys may share a bucket; dispatch skips entries of other keys.
+         */
+        template<typename TEvent> struct KeyedBucket
+        {
+            struct Entry
+            {
+                std::uint64_t key;                              ///< Subscription key
+                std::shared_ptr<const Handler<TEvent>> handler; ///< Shared handler node
+            };
+
+            std::vector<Entry> entries; ///< Handlers in dispatch order
+        };
+
+        /**
+         * @brief Power-of-two hash table of keyed handler buckets.
+         * @tparam TEvent Event type
+         * @note Each bucket is its own copy-on-write snapshot, so subscribing copies one bucket rather than
+         *       every keyed handler of the type. The table itself is only replaced when it grows.
+         */
+        template<typename TEvent> struct KeyedTable
+        {
+            explicit KeyedTable(std::size_t size) : buckets(size), mask(size - 1)
+            {
+            }
+
+            /**
+             * @brief Returns the bucket snapshot a key hashes to.
+             * @param key Subscription key
+             * @return Bucket, or null when no handler ever hashed there
+             */
+            [[nodiscard]] const KeyedBucket<TEvent> *Find(std::uint64_t key) const
+            {
+                return buckets[Detail::MixKey(key) & mask].Load();
+            }
+
+            std::vector<Detail::SnapshotPtr<const KeyedBucket<TEvent>>> buckets; ///< Bucket snapshots
+            std::size_t mask;                                                    ///< Bucket count minus one
+        };
+
+        /**
+         * @brief Points every slot at its handler's position in a snapshot.
+         * @note Dense indices count sequential handlers first, then concurrent ones.
+         */
+        template<typename TEvent>
+        static void Reindex(const HandlerList<TEvent> &list, std::vector<SubscriptionSlot> &slots)
+        {
+            std::size_t index = 0;
+            for (const auto &handler : list.handlers)
+            {
+                slots[handler->slot].denseIndex = index++;
+            }
+            for (const auto &handler : list.concurrentHandlers)
+            {
+                slots[handler->slot].denseIndex = index++;
+            }
+        }
+
+        /**
+         * @brief Calls one handler, timing it when instrumentation is enabled.
+         * @return True if the handler marked the events handled
+         */
+        template<typename TEvent> static bool Invoke(const Handler<TEvent> &handler, std::span<const TEvent> events)
+        {
+#if defined(KAPPA_ENABLE_EVENT_STATS)
+            const auto start = std::chrono::steady_clock::now();
+            const bool handled = handler.callback(events);
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            handler.counters.Record(
+                static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+            return handled;
+#else
+            return handler.callback(events);
+#endif
+        }
+
+        /**
+         * @brief Checks the return type of a per-event callback.
+         * @return True if the callback returns a handled flag
+         */
+        template<typename TEvent, typename TCallback> static constexpr bool CanMarkHandled()
+        {
+            using Result = std::invoke_result_t<std::decay_t<TCallback> &, const TEvent &>;
+            static_assert(std::is_void_v<Result> || std::is_convertible_v<Result, bool>,
+                "Event handlers must return void or a handled flag convertible to bool");
+            return !std::is_void_v<Result>;
+        }
+
+        /**
+         * @brief Wraps a per-event callback in the span-based callback every handler stores.
+         */
+        template<typename TEvent, typename TCallback>
+        static BatchCallback<TEvent> MakeEventAdapter(TCallback &&callback)
+        {
+            constexpr bool consumes = CanMarkHandled<TEvent, TCallback>();
+            auto adapter = [callback = std::forward<TCallback>(callback)](std::span<const TEvent> events) mutable {
+                bool handled = false;
+                for (const auto &event : events)
+                {
+                    if constexpr (consumes)
+                    {
+                        handled = static_cast<bool>(std::invoke(callback, event));
+                    }
+                    else
+                    {
+                        std::invoke(callback, event);
+                    }
+                }
+                return handled;
+            };
+            return BatchCallback<TEvent>(std::move(adapter));
+        }
+
+        /**
+         * @brief Calls sequential handlers in snapshot order until one reports the events handled, then fans
+         *        the concurrent handlers out across the thread pool and waits for them.
+         * @return True if dispatch was stopped by a handler
+         */
+        template<typename TEvent> bool Dispatch(const HandlerList<TEvent> &list, std::span<const TEvent> events) const
+        {
+            for (const auto &handler : list.handlers)
+            {
+                if (Invoke(*handler, events))
+                {
+                    return true;
+                }
+            }
+
+            DispatchConcurrent(list, events);
+            return false;
+        }
+
+        /**
+         * @brief Interleaves the handlers of one key with the sequential wildcard handlers by priority, then
+         *        runs the concurrent handlers like Dispatch().
+         * @param bucket Bucket the key hashes to, may be null
+         * @return True if dispatch was stopped by a handler
+         * @note On equal priority the keyed handler runs first, as the more specific subscriber.
+         */
+        template<typename TEvent>
+        bool DispatchKeyed(const HandlerList<TEvent> &list,
+            const KeyedBucket<TEvent> *bucket,
+            std::uint64_t key,
+            std::span<const TEvent> events) const
+        {
+            if (!bucket)
+            {
+                return Dispatch(list, events);
+            }
+
+            auto wildcard = list.handlers.begin();
+            for (const auto &entry : bucket->entries)
+            {
+                if (entry.key != key)
+                {
+                    continue;
+                }
+
+                for (; wildcard != list.handlers.end() && (*wildcard)->priority > entry.handler->priority; ++wildcard)
+                {
+                    if (Invoke(**wildcard, events))
+                    {
+                        return true;
+                    }
+                }
+
+                if (Invoke(*entry.handler, events))
+                {
+                    return true;
+                }
+            }
+
+            for (; wildcard != list.handlers.end(); ++wildcard)
+            {
+                if (Invoke(**wildcard, events))
+                {
+                    return true;
+                }
+            }
+
+            DispatchConcurrent(list, events);
+            return false;
+        }
+
+        /**
+         * @brief Fans the concurrent handlers of a snapshot out across the thread pool and waits for them.
+         */
+        template<typename TEvent>
+        void DispatchConcurrent(const HandlerList<TEvent> &list, std::span<const TEvent> events) const
+        {
+            const auto &concurrent = list.concurrentHandlers;
+            auto *pool = threadPool.load(std::memory_order_acquire);
+            if (pool && concurrent.size() > 1)
+            {
+                pool->ParallelFor(concurrent.size(), [&concurrent, events](std::size_t i) {
+                    Invoke(*concurrent[i], events);
+                });
+            }
+            else
+            {
+                for (const auto &handler : concurrent)
+                {
+                    Invoke(*handler, events);
+                }
+            }
+        }
+
+        /**
+         * @brief Type-erased owner of a per-event channel.
+         */
+        struct ChannelBase
+        {
+            virtual ~ChannelBase() = default;
+
+            /**
+             * @brief Drops every handler by publishing an empty snapshot.
+             */
+            virtual void Reset() = 0;
+
+            /**
+             * @brief Publishes a snapshot without the handler at the given position.
+             * @param denseIndex Position of the handler to remove
+             * @param slots Slot map whose dense indices are updated for shifted handlers
+             */
+            virtual void Remove(std::size_t denseIndex, std::vector<SubscriptionSlot> &slots) = 0;
+
+            /**
+             * @brief Publishes a copy of a key's bucket without the handler in the given slot.
+             * @param key Subscription key of the handler
+             * @param slot Slot index of the handler
+             */
+            virtual void RemoveKeyed(std::uint64_t key, std::uint32_t slot) = 0;
+
+#if defined(KAPPA_ENABLE_EVENT_STATS)
+            /**
+             * @brief Builds the statistics of this event type and its current handlers.
+             */
+            virtual EventTypeStats CollectStats() const = 0;
+
+            /**
+             * @brief Zeroes publish and handler counters.
+             */
+            virtual void ResetStats() = 0;
+
+            std::string_view name;                        ///< Event type name
+            mutable Detail::EventTypeCounters counters{}; ///< Publish counts, bumped by concurrent publishers
+#endif
+        };
+
+        /**
+         * @brief Handler snapshot for a single event type.
+         * @tparam TEvent Event type
+         */
+        template<typename TEvent> struct Channel final : ChannelBase
+        {
+            /**
+             * @brief Constructs an empty channel.
+             * @param retired Bus-wide list that frees replaced snapshots once publishers are done with them
+             */
+            explicit Channel(Detail::RetiredList &retired) : retired(retired)
+            {
+            }
+
+            void Reset() override
+            {
+                handlers.Store(std::make_shared<const HandlerList<TEvent>>(), retired);
+                keyed.Store(nullptr, retired);
+                keyedCount = 0;
+            }
+
+            void Remove(std::size_t denseIndex, std::vector<SubscriptionSlot> &slots) override
+            {
+                // Order-preserving removal; the slot map makes the lookup O(1) and the rebuild is the
+                // same copy-on-write cost Subscribe pays
+                auto next = std::make_shared<HandlerList<TEvent>>(*handlers.Get());
+                if (denseIndex < next->handlers.size())
+                {
+                    next->handlers.erase(next->handlers.begin() + static_cast<std::ptrdiff_t>(denseIndex));
+                }
+                else
+                {
+                    const auto offset = static_cast<std::ptrdiff_t>(denseIndex - next->handlers.size());
+                    next->concurrentHandlers.erase(next->concurrentHandlers.begin() + offset);
+                }
+
+                next->consumes = std::any_of(next->handlers.begin(),
+                    next->handlers.end(),
+                    [](const auto &handler) { return handler->consumes; });
+                Reindex(*next, slots);
+                handlers.Store(std::move(next), retired);
+            }
+
+            /**
+             * @brief Publishes a copy of a key's bucket with one more handler, growing the table first when
+             *        buckets average more than two handlers.
+             * @param key Subscription key
+             * @param handler Handler node
+             */
+            void AddKeyed(std::uint64_t key, std::shared_ptr<const Handler<TEvent>> handler)
+            {
+                auto table = keyed.Get();
+                if (!table || keyedCount >= 2 * table->buckets.size())
+                {
+                    table = RehashKeyed(table ? table->buckets.size() * 2 : 16);
+                }
+
+                auto &bucket = table->buckets[Detail::MixKey(key) & table->mask];
+                const auto &current = bucket.Get();
+                auto next = current ? std::make_shared<KeyedBucket<TEvent>>(*current)
+                                    : std::make_shared<KeyedBucket<TEvent>>();
+                const auto priority = handler->priority;
+                const auto position = std::find_if(next->entries.begin(),
+                    next->entries.end(),
+                    [priority](const auto &existing) { return existing.handler->priority < priority; });
+                next->entries.insert(position, { key, std::move(handler) });
+                bucket.Store(std::move(next), retired);
+                keyedCount++;
+            }
+
+            void RemoveKeyed(std::uint64_t key, std::uint32_t slot) override
+            {
+                const auto &table = keyed.Get();
+                if (!table)
+                {
+                    return;
+                }
+
+                auto &bucket = table->buckets[Detail::MixKey(key) & table->mask];
+                auto next = std::make_shared<KeyedBucket<TEvent>>(*bucket.Get());
+                std::erase_if(next->entries, [slot](const auto &entry) { return entry.handler->slot == slot; });
+                bucket.Store(std::move(next), retired);
+                keyedCount--;
+            }
+
+            /**
+             * @brief Calls a function for every keyed handler.
+             * @note Writers only, like the other Get() users.
+             */
+            template<typename TFunction> void ForEachKeyed(TFunction &&function) const
+            {
+                if (const auto &table = keyed.Get())
+                {
+                    for (const auto &bucket : table->buckets)
+                    {
+                        if (const auto &current = bucket.Get())
+                        {
+                            for (const auto &entry : current->entries)
+                            {
+                                function(*entry.handler);
+                            }
+                        }
+                    }
+                }
+            }
+
+            /**
+             * @brief Replaces the keyed table with a larger one holding the same handlers.
+             * @param size New bucket count, a power of two
+             * @return The new table
+             * @note Per-key order survives because each key's entries all come from one old bucket.
+             */
+            std::shared_ptr<KeyedTable<TEvent>> RehashKeyed(std::size_t size)
+            {
+                std::vector<std::vector<typename KeyedBucket<TEvent>::Entry>> entries(size);
+                if (const auto &table = keyed.Get())
+                {
+                    for (const auto &bucket : table->buckets)
+                    {
+                        if (const auto &current = bucket.Get())
+                        {
+                            for (const auto &entry : current->entries)
+                            {
+                                entries[Detail::MixKey(entry.key) & (size - 1)].push_back(entry);
+                            }
+                        }
+                    }
+                }
+
+                auto grown = std::make_shared<KeyedTable<TEvent>>(size);
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    if (!entries[i].empty())
+                    {
+                        auto bucket = std::make_shared<KeyedBucket<TEvent>>();
+                        bucket->entries = std::move(entries[i]);
+                        grown->buckets[i].Store(std::move(bucket), retired);
+                    }
+                }
+
+                keyed.Store(grown, retired);
+                return grown;
+            }
+
+#if defined(KAPPA_ENABLE_EVENT_STATS)
+            EventTypeStats CollectStats() const override
+            {
+                EventTypeStats stats;
+                stats.name = name;
+                stats.publishCount = counters.publishCount.load(std::memory_order_relaxed);
+                stats.publishesLastFrame = counters.publishesLastFrame.load(std::memory_order_relaxed);
+                stats.maxPublishesPerFrame = counters.maxPublishesPerFrame.load(std::memory_order_relaxed);
+
+                const auto &current = handlers.Get();
+                auto all = current->handlers;
+                all.insert(all.end(), current->concurrentHandlers.begin(), current->concurrentHandlers.end());
+                for (const auto &handler : all)
+                {
+                    AddHandlerStats(stats, *handler);
+                }
+                ForEachKeyed([&stats](const Handler<TEvent> &handler) { AddHandlerStats(stats, handler); });
+                stats.subscriberCount = stats.handlers.size();
+                return stats;
+            }
+
+            void ResetStats() override
+            {
+                counters.Reset();
+                const auto &current = handlers.Get();
+                for (const auto &handler : current->handlers)
+                {
+                    handler->counters.Reset();
+                }
+                for (const auto &handler : current->concurrentHandlers)
+                {
+                    handler->counters.Reset();
+                }
+                ForEachKeyed([](const Handler<TEvent> &handler) { handler.counters.Reset(); });
+            }
+
+            static void AddHandlerStats(EventTypeStats &stats, const Handler<TEvent> &handler)
+            {
+                auto &entry = stats.handlers.emplace_back();
+                entry.name = handler.name;
+                entry.priority = handler.priority;
+                entry.callCount = handler.counters.callCount.load(std::memory_order_relaxed);
+                entry.totalNanoseconds = handler.counters.totalNanoseconds.load(std::memory_order_relaxed);
+                entry.maxNanoseconds = handler.counters.maxNanoseconds.load(std::memory_order_relaxed);
+                entry.latency = handler.counters.latency.Snapshot();
+
+                stats.totalHandlerNanoseconds += entry.totalNanoseconds;
+                stats.maxHandlerNanoseconds = std::max(stats.maxHandlerNanoseconds, entry.maxNanoseconds);
+            }
+#endif
+
+            Detail::SnapshotPtr<const HandlerList<TEvent>> handlers{
+                std::make_shared<const HandlerList<TEvent>>()
+            };
+            Detail::SnapshotPtr<KeyedTable<TEvent>> keyed; ///< Keyed handlers, null until the first one
+            std::size_t keyedCount = 0;                    ///< Live keyed handlers; writers only
+            Detail::RetiredList &retired;                  ///< Owned by the bus, shared by every channel
+        };
+
+        /**
+         * @brief Lookup table from dense type index to channel.
+         * @note Slots are filled in place; a table is only replaced when it has to grow. Channels outlive
+         *       every table and replaced tables are retired rather than freed, so publishers read them
+         *       without any reference counting.
+         */
+        struct ChannelTable
+        {
+            explicit ChannelTable(std::size_t size) : slots(size)
+            {
+            }
+
+            std::vector<std::atomic<ChannelBase *>> slots;
+        };
+
+        /**
+         * @brief Dispatches one event to the handlers of TTarget and then of each of its parents.
+         * @return True if a handler marked the event handled
+         * @note Unrolled at compile time into one table lookup per level of the chain.
+         */
+        template<typename TTarget> bool DispatchChain(const TTarget &event) const
+        {
+            if (const auto *channel = FindChannel<TTarget>())
+            {
+                if (Dispatch(*channel->handlers.Load(), std::span<const TTarget>(&event, 1)))
+                {
+                    return true;
+                }
+            }
+
+            if constexpr (!std::is_void_v<Detail::ParentEvent<TTarget>>)
+            {
+                return DispatchChain<Detail::ParentEvent<TTarget>>(event);
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        /**
+         * @brief Dispatches one event to the handlers of a key and the wildcard handlers of TTarget, then of
+         *        each of its parents.
+         * @return True if a handler marked the event handled
+         */
+        template<typename TTarget> bool DispatchKeyedChain(std::uint64_t key, const TTarget &event) const
+        {
+            if (const auto *channel = FindChannel<TTarget>())
+            {
+                const auto *table = channel->keyed.Load();
+                const auto *bucket = table ? table->Find(key) : nullptr;
+                if (DispatchKeyed(*channel->handlers.Load(), bucket, key, std::span<const TTarget>(&event, 1)))
+                {
+                    return true;
+                }
+            }
+
+            if constexpr (!std::is_void_v<Detail::ParentEvent<TTarget>>)
+            {
+                return DispatchKeyedChain<Detail::ParentEvent<TTarget>>(key, event);
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        template<typename TEvent>
+        Subscription AddHandler(
+            BatchCallback<TEvent> &&callback, int priority, bool consumes, bool concurrent, std::string_view name)
+        {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            auto &channel = GetOrCreateChannel<TEvent>();
+
+            // Copy-on-write: in-flight publishes keep iterating the previous snapshot. Sorting happens
+            // here, once, so publishing never has to reorder handlers.
+            auto next = std::make_shared<HandlerList<TEvent>>(*channel.handlers.Get());
+            next->consumes = next->consumes || consumes;
+
+            const auto slot = AllocateSlot(channel, 0);
+            auto handler = std::make_shared<const Handler<TEvent>>(std::move(callback), slot, priority, consumes, name);
+            if (concurrent)
+            {
+                next->concurrentHandlers.push_back(std::move(handler));
+            }
+            else
+            {
+                const auto position = std::find_if(next->handlers.begin(),
+                    next->handlers.end(),
+                    [priority](const auto &existing) { return existing->priority < priority; });
+                next->handlers.insert(position, std::move(handler));
+            }
+
+            Reindex(*next, slots);
+            channel.handlers.Store(std::move(next), retired);
+
+            return MakeSubscription(slot, slots[slot].generation);
+        }
+
+        template<typename TEvent>
+        Subscription AddKeyedHandler(
+            std::uint64_t key, BatchCallback<TEvent> &&callback, int priority, bool consumes, std::string_view name)
+        {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            auto &channel = GetOrCreateChannel<TEvent>();
+
+            const auto slot = AllocateSlot(channel, 0);
+            slots[slot].key = key;
+            slots[slot].keyed = true;
+            channel.AddKeyed(
+                key, std::make_shared<const Handler<TEvent>>(std::move(callback), slot, priority, consumes, name));
+
+            return MakeSubscription(slot, slots[slot].generation);
+        }
+
+        /**
+         * @brief Counts published events; creates the channel so unobserved types are counted too.
+         */
+        template<typename TEvent> void RecordPublishes([[maybe_unused]] std::size_t count)
+        {
+#if defined(KAPPA_ENABLE_EVENT_STATS)
+            if (!FindChannel<TEvent>())
+            {
+                std::lock_guard<std::mutex> lock(writerMutex);
+                GetOrCreateChannel<TEvent>();
+            }
+            FindChannel<TEvent>()->counters.Record(count);
+#endif
+        }
+
+        template<typename TEvent> const Channel<TEvent> *FindChannel() const
+        {
+            const auto *table = channelTable.load(std::memory_order_acquire);
+            const auto index = Detail::EventTypeIndex<TEvent>();
+            if (!table || index >= table->slots.size())
+            {
+                return nullptr;
+            }
+
+            // The slot for a given index only ever holds Channel<TEvent>, so no RTTI is needed
+            return static_cast<const Channel<TEvent> *>(table->slots[index].load(std::memory_order_acquire));
+        }
+
+        template<typename TEvent> Channel<TEvent> &GetOrCreateChannel()
+        {
+            const auto index = Detail::EventTypeIndex<TEvent>();
+            auto *table = channelTable.load(std::memory_order_relaxed);
+            if (table && index < table->slots.size())
+            {
+                if (auto *existing = table->slots[index].load(std::memory_order_relaxed))
+                {
+                    return static_cast<Channel<TEvent> &>(*existing);
+                }
+            }
+            else
+            {
+                // Grow geometrically so the retired tables stay proportional to the number of event types
+                const auto currentSize = table ? table->slots.size() : 0;
+                auto grown = std::make_unique<ChannelTable>(std::max(index + 1, currentSize * 2));
+                for (std::size_t i = 0; i < currentSize; ++i)
+                {
+                    grown->slots[i].store(table->slots[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+                }
+
+                table = grown.get();
+                channelTables.push_back(std::move(grown));
+                channelTable.store(table, std::memory_order_release);
+            }
+
+            auto &channel = channelStorage.emplace_back(std::make_unique<Channel<TEvent>>(retired));
+#if defined(KAPPA_ENABLE_EVENT_STATS)
+            channel->name = Detail::TypeName<TEvent>();
+#endif
+            table->slots[index].store(channel.get(), std::memory_order_release);
+
+            return static_cast<Channel<TEvent> &>(*channel);
+        }
+
+        std::uint32_t AllocateSlot(ChannelBase &channel, std::size_t denseIndex)
+        {
+            std::uint32_t slot;
+            if (!freeSlots.empty())
+            {
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+            }
+            else
+            {
+                slot = static_cast<std::uint32_t>(slots.size());
+                slots.emplace_back();
+            }
+
+            slots[slot].channel = &channel;
+            slots[slot].denseIndex = denseIndex;
+            return slot;
+        }
+
+        void FreeSlot(std::uint32_t slot)
+        {
+            slots[slot].channel = nullptr;
+            slots[slot].keyed = false;
+            slots[slot].generation++;
+            freeSlots.push_back(slot);
+        }
+
+        /**
+         * @brief Removes the handler a Subscription token refers to.
+         * @param slot Slot index
+         * @param generation Generation the token was issued with
+         */
+        void Unsubscribe(std::uint32_t slot, std::uint32_t generation) override
+        {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            if (slot >= slots.size() || slots[slot].generation != generation || !slots[slot].channel)
+            {
+                return;
+            }
+
+            if (slots[slot].keyed)
+            {
+                slots[slot].channel->RemoveKeyed(slots[slot].key, slot);
+            }
+            else
+            {
+                slots[slot].channel->Remove(slots[slot].denseIndex, slots);
+            }
+            FreeSlot(slot);
+        }
+
+        std::vector<SubscriptionSlot> slots;                      ///< Generational slot map of live subscriptions
+        std::vector<std::uint32_t> freeSlots;                     ///< Released slots available for reuse
+        std::vector<std::unique_ptr<QueueBase>> queues;           ///< Deferred queues indexed by dense type index
+        std::vector<QueueBase *> queueOrder;                      ///< Deferred queues in dispatch order
+        Detail::RetiredList retired;                              ///< Replaced snapshots awaiting in-flight publishers
+        std::vector<std::unique_ptr<ChannelBase>> channelStorage; ///< Owns every channel ever created
+        std::vector<std::unique_ptr<ChannelTable>> channelTables; ///< Current and retired lookup tables
+        std::atomic<ChannelTable *> channelTable = nullptr;       ///< Table read by publishers
+        std::atomic<ThreadPool *> threadPool = nullptr;           ///< Workers for concurrent handlers, may be null
+        mutable std::mutex writerMutex;                           ///< Serializes Subscribe, Clear and stats queries
+#if defined(KAPPA_ENABLE_EVENT_STATS)
+        std::uint64_t statsFrameCount = 0; ///< Frames closed by EndStatsFrame()
+#endif
+    };
+
+    /**
+     * @brief Awaiter returned by EventBus::Next(); subscribes while the task is suspended.
+     * @tparam TEvent Event type
+     * @note The first matching event is copied into shared state and the task is queued on its scheduler,
+     *       which may happen on any publishing thread. The handler holds that state by reference count, so a
+     *       publisher that loaded the handler snapshot before the subscription was dropped never touches a
+     *       destroyed awaiter. Cancelling the task drops the subscription.
+     */
+    template<typename TEvent> class NextEventAwaiter
+    {
+    public:
+        explicit NextEventAwaiter(EventBus &bus) : bus(bus)
+        {
+        }
+
+        [[nodiscard]] bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        template<typename TPromise> void await_suspend(std::coroutine_handle<TPromise> handle)
+        {
+            const auto context = handle.promise().context;
+            assert(context.scheduler && "EventBus::Next() awaited outside a spawned task");
+            state = std::make_shared<State>();
+            subscription = bus.Subscribe<TEvent>([state = state, handle, context](const TEvent &event) {
+                if (!state->fired.exchange(true, std::memory_order_acq_rel))
+                {
+                    state->value.emplace(event);
+                    context.scheduler->Schedule(handle, context);
+                }
+            });
+        }
+
+        TEvent await_resume()
+        {
+            subscription.Reset();
+            return std::move(*state->value);
+        }
+
+    private:
+        /**
+         * @brief Delivery state shared with the handler, which may outlive the awaiter on another thread.
+         */
+        struct State
+        {
+            std::optional<TEvent> value;     ///< First event published after suspension
+            std::atomic<bool> fired = false; ///< Set by the first event so later ones are ignored
+        };
+
+        EventBus &bus;                ///< Bus the awaiter subscribes to
+        Subscription subscription;    ///< Active while the task is suspended
+        std::shared_ptr<State> state; ///< Created on suspension, shared with the handler
     };
 } // namespace Kappa
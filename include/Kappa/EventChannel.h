@@ -0,0 +1,244 @@
+#pragma once
+
+#include "Event.h"
+#include "EventBus.h"
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace Kappa
+{
+    /**
+     * @brief What a producer does when an EventChannel is full.
+     */
+    enum class OverflowPolicy
+    {
+        Block = 0,      ///< Wait until the consumer frees a slot
+        DropOldest = 1, ///< Discard the oldest queued event to make room
+        DropNewest = 2  ///< Discard the event being pushed
+    };
+
+    /**
+     * @brief Configuration for creating an event channel.
+     */
+    struct EventChannelSpecification
+    {
+        std::size_t capacity = 1024;                                ///< Queue size (rounded up to a power of 2)
+        OverflowPolicy overflowPolicy = OverflowPolicy::DropNewest; ///< Behavior when the channel is full
+    };
+
+    /**
+     * @brief Type-erased interface used by Application to drain channels.
+     */
+    class EventChannelBase
+    {
+    public:
+        /**
+         * @brief Virtual destructor for proper cleanup of derived classes.
+         */
+        virtual ~EventChannelBase() = default;
+
+        /**
+         * @brief Publishes queued events to a bus on the calling (consumer) thread.
+         * @param bus Bus to publish to
+         * @return Number of events delivered
+         */
+        virtual std::size_t Drain(EventBus &bus) = 0;
+    };
+
+    /**
+     * @brief Bounded lock-free multi-producer/single-consumer channel for injecting events from worker threads.
+     * @tparam TEvent Event type (must derive from Event)
+     * @note Any thread may push; only the owning thread (the main loop) drains. Events are stored by value in
+     *       a fixed ring buffer of sequence-stamped cells, so pushing never allocates or takes a lock.
+     */
+    template<typename TEvent>
+        requires std::is_base_of_v<Event, TEvent>
+    class EventChannel final : public EventChannelBase
+    {
+    public:
+        /**
+         * @brief Constructs a channel.
+         * @param spec Channel configuration
+         */
+        explicit EventChannel(const EventChannelSpecification &spec = EventChannelSpecification())
+            : capacity(std::bit_ceil(spec.capacity < 2 ? std::size_t{ 2 } : spec.capacity)), mask(capacity - 1),
+              overflowPolicy(spec.overflowPolicy), cells(std::make_unique<Cell[]>(capacity))
+        {
+            for (std::size_t i = 0; i < capacity; ++i)
+            {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Destructor - destroys events that were never drained.
+         */
+        ~EventChannel() override
+        {
+            while (TryConsume([](TEvent &) {}))
+            {
+            }
+        }
+
+        EventChannel(const EventChannel &) = delete;
+        EventChannel &operator=(const EventChannel &) = delete;
+
+        /**
+         * @brief Pushes an event from any thread, applying the overflow policy when full.
+         * @param event Event to push
+         * @return True if the event was queued, false if it was dropped (DropNewest)
+         */
+        bool Push(TEvent event)
+        {
+            while (!TryEnqueue(event))
+            {
+                switch (overflowPolicy)
+                {
+                case OverflowPolicy::Block:
+                    std::this_thread::yield();
+                    break;
+                case OverflowPolicy::DropOldest:
+                    if (TryConsume([](TEvent &) {}))
+                    {
+                        droppedCount.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    break;
+                case OverflowPolicy::DropNewest:
+                    droppedCount.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Publishes every event queued so far to a bus.
+         * @param bus Bus to publish to
+         * @return Number of events delivered
+         * @note Consumer thread only. Stops after one ring's worth of events so busy producers can't
+         *       starve the frame.
+         */
+        std::size_t Drain(EventBus &bus) override
+        {
+            std::size_t delivered = 0;
+            const auto publish = [&bus](TEvent &event) { bus.Publish(std::as_const(event)); };
+            while (delivered < capacity && TryConsume(publish))
+            {
+                ++delivered;
+            }
+            return delivered;
+        }
+
+        /**
+         * @brief Returns how many events were discarded by the overflow policy.
+         * @return Dropped event count
+         */
+        [[nodiscard]] std::uint64_t GetDroppedCount() const
+        {
+            return droppedCount.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Returns the ring capacity.
+         * @return Capacity after rounding to a power of two
+         */
+        [[nodiscard]] std::size_t GetCapacity() const
+        {
+            return capacity;
+        }
+
+    private:
+        /**
+         * @brief Ring cell; the sequence number tells producers and consumers whose turn it is.
+         */
+        struct Cell
+        {
+            std::atomic<std::size_t> sequence{ 0 };            ///< Turn counter for this cell
+            alignas(TEvent) std::byte storage[sizeof(TEvent)]; ///< Event storage
+        };
+
+        static constexpr std::size_t cacheLineSize = 64;
+
+        bool TryEnqueue(TEvent &event)
+        {
+            auto position = enqueuePosition.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                auto &cell = cells[position & mask];
+                const auto sequence = cell.sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+                if (difference == 0)
+                {
+                    if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        ::new (static_cast<void *>(cell.storage)) TEvent(std::move(event));
+                        cell.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    position = enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief Pops the oldest event and hands it to a visitor.
+         * @note Safe to call from producers (DropOldest) concurrently with the consumer. The event is moved
+         *       out and its cell released before the visitor runs, so a throwing handler can't leave the
+         *       cell occupied and wedge the ring.
+         */
+        template<typename TVisitor> bool TryConsume(TVisitor &&visitor)
+        {
+            auto position = dequeuePosition.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                auto &cell = cells[position & mask];
+                const auto sequence = cell.sequence.load(std::memory_order_acquire);
+                const auto difference =
+                    static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+                if (difference == 0)
+                {
+                    if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        auto *stored = std::launder(reinterpret_cast<TEvent *>(cell.storage));
+                        TEvent event(std::move(*stored));
+                        stored->~TEvent();
+                        cell.sequence.store(position + capacity, std::memory_order_release);
+                        visitor(event);
+                        return true;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    position = dequeuePosition.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        const std::size_t capacity;                                           ///< Number of cells (power of two)
+        const std::size_t mask;                                               ///< capacity - 1
+        const OverflowPolicy overflowPolicy;                                  ///< Behavior when full
+        std::unique_ptr<Cell[]> cells;                                        ///< Ring storage
+        alignas(cacheLineSize) std::atomic<std::size_t> enqueuePosition{ 0 }; ///< Next producer ticket
+        alignas(cacheLineSize) std::atomic<std::size_t> dequeuePosition{ 0 }; ///< Next consumer ticket
+        alignas(cacheLineSize) std::atomic<std::uint64_t> droppedCount{ 0 };  ///< Events discarded on overflow
+    };
+} // namespace Kappa
@@ -0,0 +1,516 @@
+#pragma once
+
+#include "Event.h"
+#include "EventBus.h"
+#include "EventStats.h"
+#include "Layer.h"
+#include "Subscription.h"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace Kappa
+{
+    /**
+     * @brief Growable byte buffer that event serializers write into.
+     * @note Values are stored in native byte order, so recordings are only portable between machines of
+     *       the same endianness.
+     */
+    class BinaryWriter
+    {
+    public:
+        /**
+         * @brief Appends a trivially copyable value.
+         * @tparam T Value type
+         * @param value Value to append
+         */
+        template<typename T>
+            requires std::is_trivially_copyable_v<T>
+        void Write(const T &value)
+        {
+            WriteBytes(&value, sizeof(T));
+        }
+
+        /**
+         * @brief Appends raw bytes.
+         * @param bytes Source bytes
+         * @param size Number of bytes
+         */
+        void WriteBytes(const void *bytes, std::size_t size)
+        {
+            const auto offset = buffer.size();
+            buffer.resize(offset + size);
+            if (size > 0)
+            {
+                std::memcpy(buffer.data() + offset, bytes, size);
+            }
+        }
+
+        /**
+         * @brief Appends an unsigned integer in LEB128 form (one byte for values below 128).
+         * @param value Value to append
+         */
+        void WriteVarint(std::uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                buffer.push_back(static_cast<std::byte>((value & 0x7F) | 0x80));
+                value >>= 7;
+            }
+            buffer.push_back(static_cast<std::byte>(value));
+        }
+
+        /**
+         * @brief Appends a length-prefixed string.
+         * @param value String to append
+         */
+        void WriteString(std::string_view value)
+        {
+            WriteVarint(value.size());
+            WriteBytes(value.data(), value.size());
+        }
+
+        /**
+         * @brief Returns the bytes written so far.
+         * @return View of the buffer
+         */
+        [[nodiscard]] std::span<const std::byte> GetData() const
+        {
+            return buffer;
+        }
+
+        /**
+         * @brief Empties the buffer, keeping its capacity.
+         */
+        void Clear()
+        {
+            buffer.clear();
+        }
+
+    private:
+        std::vector<std::byte> buffer; ///< Written bytes
+    };
+
+    /**
+     * @brief Bounds-checked cursor over bytes written by BinaryWriter.
+     * @note Reading past the end yields value-initialized results and marks the reader invalid instead of
+     *       throwing, so a truncated recording can be detected after the fact.
+     */
+    class BinaryReader
+    {
+    public:
+        /**
+         * @brief Constructs a reader over a byte range.
+         * @param data Bytes to read; must outlive the reader
+         */
+        explicit BinaryReader(std::span<const std::byte> data) : data(data)
+        {
+        }
+
+        /**
+         * @brief Reads a trivially copyable value.
+         * @tparam T Value type
+         * @return Value read, or a value-initialized T past the end
+         */
+        template<typename T>
+            requires std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>
+        [[nodiscard]] T Read()
+        {
+            T value{};
+            ReadBytes(&value, sizeof(T));
+            return value;
+        }
+
+        /**
+         * @brief Reads raw bytes.
+         * @param bytes Destination
+         * @param size Number of bytes
+         * @return True if enough bytes were left
+         */
+        bool ReadBytes(void *bytes, std::size_t size)
+        {
+            if (size > GetRemaining())
+            {
+                valid = false;
+                offset = data.size();
+                return false;
+            }
+
+            if (size > 0)
+            {
+                std::memcpy(bytes, data.data() + offset, size);
+            }
+            offset += size;
+            return true;
+        }
+
+        /**
+         * @brief Skips bytes without reading them.
+         * @param size Number of bytes
+         * @return True if enough bytes were left
+         */
+        bool Skip(std::size_t size)
+        {
+            if (size > GetRemaining())
+            {
+                valid = false;
+                offset = data.size();
+                return false;
+            }
+
+            offset += size;
+            return true;
+        }
+
+        /**
+         * @brief Reads an unsigned LEB128 integer.
+         * @return Value read, or 0 if the input is truncated or longer than 64 bits
+         */
+        [[nodiscard]] std::uint64_t ReadVarint()
+        {
+            std::uint64_t value = 0;
+            for (unsigned shift = 0; shift < 64; shift += 7)
+            {
+                if (offset >= data.size())
+                {
+                    break;
+                }
+
+                const auto byte = std::to_integer<std::uint64_t>(data[offset++]);
+                value |= (byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                {
+                    return value;
+                }
+            }
+
+            valid = false;
+            offset = data.size();
+            return 0;
+        }
+
+        /**
+         * @brief Reads a length-prefixed string.
+         * @return String read, empty if the input is truncated
+         */
+        [[nodiscard]] std::string ReadString()
+        {
+            const auto size = ReadVarint();
+            if (size > GetRemaining())
+            {
+                valid = false;
+                offset = data.size();
+                return {};
+            }
+
+            std::string value(reinterpret_cast<const char *>(data.data() + offset), static_cast<std::size_t>(size));
+            offset += static_cast<std::size_t>(size);
+            return value;
+        }
+
+        /**
+         * @brief Returns the number of unread bytes.
+         * @return Remaining byte count
+         */
+        [[nodiscard]] std::size_t GetRemaining() const
+        {
+            return data.size() - offset;
+        }
+
+        /**
+         * @brief Checks that no read ran past the end.
+         * @return True if every read succeeded
+         */
+        [[nodiscard]] bool IsValid() const
+        {
+            return valid;
+        }
+
+    private:
+        std::span<const std::byte> data; ///< Bytes being read
+        std::size_t offset = 0;          ///< Position of the next read
+        bool valid = true;               ///< Cleared by the first out-of-range read
+    };
+
+    /**
+     * @brief Serializer trait for recording an event type; specialize it for every recorded event.
+     * @tparam TEvent Event type
+     * @note A specialization provides `static void Write(BinaryWriter &, const TEvent &)` and
+     *       `static TEvent Read(BinaryReader &)`. Events carry a vtable, so there is no memcpy default.
+     */
+    template<typename TEvent> struct EventSerializer;
+
+    /**
+     * @brief Satisfied by event types with an EventSerializer specialization.
+     */
+    template<typename TEvent>
+    concept SerializableEvent = std::is_base_of_v<Event, TEvent> &&
+                                requires(BinaryWriter &writer, BinaryReader &reader, const TEvent &event) {
+                                    EventSerializer<TEvent>::Write(writer, event);
+                                    { EventSerializer<TEvent>::Read(reader) } -> std::same_as<TEvent>;
+                                };
+
+    namespace Detail
+    {
+        /**
+         * @brief Record tags of the recording format.
+         * @note A file is the magic and version followed by records. Type records map a small id to an event
+         *       type name; event records hold the frame delta, type id and payload, and keyed event records
+         *       add the publish key after the type id; the end record holds the frame count and is missing if
+         *       the recording process died. Version 1 files, which have no keyed records, still load.
+         */
+        enum class RecordTag : std::uint8_t
+        {
+            Type = 0,
+            Event = 1,
+            End = 2,
+            KeyedEvent = 3,
+        };
+
+        inline constexpr char RecordingMagic[4] = { 'K', 'E', 'V', 'R' };
+        inline constexpr std::uint32_t RecordingVersion = 2;
+    } // namespace Detail
+
+    /**
+     * @brief Appends events published on an EventBus to a compact binary file, stamped with the frame index.
+     * @note Each recorded type is observed by a handler with the highest priority, so events are captured
+     *       before any handler can mark them handled. Record the events that enter the frame from outside
+     *       (input, window, channel events): events published by handlers are reproduced by replaying
+     *       their cause and would otherwise be delivered twice. Subscribers of a parent type see derived
+     *       events, so record exact types. Events published with Publish(key, event) are recorded with their
+     *       key and replayed under it. Thread-safe with respect to concurrent publishers.
+     */
+    class EventRecorder
+    {
+    public:
+        /**
+         * @brief Constructs a recorder for a bus.
+         * @param bus Bus whose events are recorded; must outlive the recorder
+         */
+        explicit EventRecorder(EventBus &bus) : bus(bus)
+        {
+        }
+
+        /**
+         * @brief Closes the file, writing the end record.
+         */
+        ~EventRecorder();
+
+        EventRecorder(const EventRecorder &) = delete;
+        EventRecorder &operator=(const EventRecorder &) = delete;
+
+        /**
+         * @brief Starts a new recording, replacing any existing file.
+         * @param filePath Path of the recording
+         * @return True if the file was opened
+         * @note Resets the frame index; an open recording is closed first.
+         */
+        bool Open(const std::string &filePath);
+
+        /**
+         * @brief Writes the end record and closes the file.
+         */
+        void Close();
+
+        /**
+         * @brief Checks whether a recording is open.
+         * @return True between a successful Open() and Close()
+         */
+        [[nodiscard]] bool IsRecording() const
+        {
+            return file.is_open();
+        }
+
+        /**
+         * @brief Starts recording events of a type.
+         * @tparam TEvent Event type with an EventSerializer specialization
+         * @note May be called before or after Open(); calling it twice for a type records events twice.
+         */
+        template<SerializableEvent TEvent> void Record()
+        {
+            const auto typeId = DeclareType(Detail::TypeName<TEvent>());
+            subscriptions.push_back(bus.Subscribe<TEvent>(
+                [this, typeId](const TEvent &event) {
+                    const auto key = EventBus::GetPublishKey();
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!file.is_open())
+                    {
+                        return;
+                    }
+
+                    payload.Clear();
+                    EventSerializer<TEvent>::Write(payload, event);
+                    AppendEvent(typeId, key);
+                },
+                std::numeric_limits<int>::max()));
+        }
+
+        /**
+         * @brief Advances the frame index and flushes buffered records to the file.
+         * @note Application::Run calls this once per frame for a recorder set with SetEventRecorder().
+         */
+        void EndFrame();
+
+        /**
+         * @brief Returns the index of the frame being recorded.
+         * @return Frames ended since Open()
+         */
+        [[nodiscard]] std::uint64_t GetFrameIndex() const;
+
+        /**
+         * @brief Returns the number of events recorded since Open().
+         * @return Event count
+         */
+        [[nodiscard]] std::uint64_t GetEventCount() const;
+
+    private:
+        std::uint32_t DeclareType(std::string_view name);
+        void WriteTypeRecord(std::uint32_t typeId);
+        void AppendEvent(std::uint32_t typeId, std::optional<std::uint64_t> key);
+        void Flush();
+
+        EventBus &bus;                           ///< Bus being recorded
+        std::vector<Subscription> subscriptions; ///< One observer per recorded type
+        std::vector<std::string> typeNames;      ///< Event type names indexed by type id
+        std::ofstream file;                      ///< Open recording
+        BinaryWriter payload;                    ///< Scratch buffer for the event being serialized
+        BinaryWriter records;                    ///< Records not yet flushed to the file
+        std::uint64_t frameIndex = 0;            ///< Frame being recorded
+        std::uint64_t lastEventFrame = 0;        ///< Frame of the previous event record
+        std::uint64_t eventCount = 0;            ///< Events recorded since Open()
+        mutable std::mutex mutex;                ///< Serializes concurrent publishers and EndFrame()
+    };
+
+    /**
+     * @brief Re-publishes a recording frame by frame, for reproducing field hitches deterministically.
+     * @note The whole file is loaded and indexed by Open(), so replay does no I/O. Register every recorded
+     *       type that should be published; events of unregistered types are skipped. Keyed events are
+     *       published with Publish(key, event), so keyed subscribers receive them as they did when recorded.
+     */
+    class EventReplayer
+    {
+    public:
+        /**
+         * @brief Loads and indexes a recording.
+         * @param filePath Path of the recording
+         * @return True if the file was read and has a valid header; a truncated tail is tolerated
+         * @note Rewinds to the first frame.
+         */
+        bool Open(const std::string &filePath);
+
+        /**
+         * @brief Publishes recorded events of a type.
+         * @tparam TEvent Event type with an EventSerializer specialization
+         */
+        template<SerializableEvent TEvent> void Register()
+        {
+            publishers[std::string(Detail::TypeName<TEvent>())] =
+                [](BinaryReader &reader, EventBus &bus, std::optional<std::uint64_t> key) {
+                    const auto event = EventSerializer<TEvent>::Read(reader);
+                    if (!reader.IsValid())
+                    {
+                        return;
+                    }
+
+                    if (key)
+                    {
+                        bus.Publish(*key, event);
+                    }
+                    else
+                    {
+                        bus.Publish(event);
+                    }
+                };
+            ResolvePublishers();
+        }
+
+        /**
+         * @brief Publishes the events of the current frame and advances to the next one.
+         * @param bus Bus to publish to
+         * @return False once every frame has been replayed
+         */
+        bool PublishFrame(EventBus &bus);
+
+        /**
+         * @brief Replays the remaining frames headlessly with a fixed timestep.
+         * @param bus Bus to publish to; normally the bus the layers subscribed to
+         * @param layers Layers to update after each frame's events are published
+         * @param timestep Delta time passed to every OnUpdate call, in seconds
+         * @return Number of frames replayed
+         * @note Each frame publishes its events, runs the update pass and delivers deferred events, like
+         *       Application::Run without a window or render pass.
+         */
+        std::uint64_t Run(EventBus &bus, std::span<const std::unique_ptr<Layer>> layers, float timestep);
+
+        /**
+         * @brief Starts the replay over from the first frame.
+         */
+        void Rewind();
+
+        /**
+         * @brief Returns the index of the next frame to replay.
+         * @return Frame index
+         */
+        [[nodiscard]] std::uint64_t GetFrameIndex() const
+        {
+            return frameIndex;
+        }
+
+        /**
+         * @brief Returns the number of recorded frames.
+         * @return Frame count
+         */
+        [[nodiscard]] std::uint64_t GetFrameCount() const
+        {
+            return frameCount;
+        }
+
+        /**
+         * @brief Returns the number of recorded events.
+         * @return Event count
+         */
+        [[nodiscard]] std::size_t GetEventCount() const
+        {
+            return events.size();
+        }
+
+    private:
+        using Publisher = void (*)(BinaryReader &, EventBus &, std::optional<std::uint64_t>);
+
+        /**
+         * @brief Location of one recorded event in the loaded file.
+         */
+        struct RecordedEvent
+        {
+            std::uint64_t frame;               ///< Frame the event was published in
+            std::uint32_t typeId;              ///< Index into typeNames
+            std::size_t offset;                ///< Payload position in data
+            std::size_t size;                  ///< Payload size in bytes
+            std::optional<std::uint64_t> key; ///< Publish key, if the event was published under one
+        };
+
+        void ResolvePublishers();
+
+        std::vector<std::byte> data;                           ///< Loaded recording
+        std::vector<std::string> typeNames;                    ///< Recorded type names indexed by type id
+        std::vector<RecordedEvent> events;                     ///< Recorded events in publish order
+        std::unordered_map<std::string, Publisher> publishers; ///< Registered types by name
+        std::vector<Publisher> resolved;                       ///< Publisher per type id, null if unregistered
+        std::uint64_t frameCount = 0;                          ///< Number of recorded frames
+        std::uint64_t frameIndex = 0;                          ///< Next frame to replay
+        std::size_t nextEvent = 0;                             ///< Next event to publish
+    };
+} // namespace Kappa
@@ -0,0 +1,323 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Kappa
+{
+    /**
+     * @brief Log-linear (HDR-style) latency histogram with bounded relative error.
+     * @note Values below 32 ns are exact; above that each power-of-two range is split into 16 buckets,
+     *       so any recorded value is reported within 1/16 (~6%) of its true value. Values are clamped
+     *       to about 18 minutes.
+     */
+    class LatencyHistogram
+    {
+    public:
+        static constexpr std::size_t SubBucketCount = 16; ///< Buckets per power-of-two range
+        static constexpr std::size_t MaxValueBits = 40;   ///< Largest tracked value is 2^40 - 1 ns
+        static constexpr std::size_t BucketCount = 2 * SubBucketCount + (MaxValueBits - 5) * SubBucketCount;
+
+        /**
+         * @brief Maps a value to its bucket.
+         * @param nanoseconds Value to map
+         * @return Bucket index
+         */
+        static constexpr std::size_t BucketIndex(std::uint64_t nanoseconds)
+        {
+            constexpr std::uint64_t maxValue = (std::uint64_t{ 1 } << MaxValueBits) - 1;
+            const auto value = std::min(nanoseconds, maxValue);
+            if (value < 2 * SubBucketCount)
+            {
+                return static_cast<std::size_t>(value);
+            }
+
+            const auto shift = static_cast<std::size_t>(std::bit_width(value)) - 5;
+            const auto subBucket = static_cast<std::size_t>(value >> shift) - SubBucketCount;
+            return 2 * SubBucketCount + (shift - 1) * SubBucketCount + subBucket;
+        }
+
+        /**
+         * @brief Returns the highest value that maps to a bucket.
+         * @param index Bucket index
+         * @return Inclusive upper bound of the bucket in nanoseconds
+         */
+        static constexpr std::uint64_t BucketUpperBound(std::size_t index)
+        {
+            if (index < 2 * SubBucketCount)
+            {
+                return index;
+            }
+
+            const auto shift = (index - 2 * SubBucketCount) / SubBucketCount + 1;
+            const auto subBucket = (index - 2 * SubBucketCount) % SubBucketCount;
+            return ((static_cast<std::uint64_t>(SubBucketCount + subBucket) + 1) << shift) - 1;
+        }
+
+        /**
+         * @brief Records one sample.
+         * @param nanoseconds Sample value
+         */
+        void Record(std::uint64_t nanoseconds)
+        {
+            buckets[BucketIndex(nanoseconds)]++;
+            count++;
+        }
+
+        /**
+         * @brief Returns the number of recorded samples.
+         * @return Sample count
+         */
+        [[nodiscard]] std::uint64_t GetCount() const
+        {
+            return count;
+        }
+
+        /**
+         * @brief Returns the value below which a given share of samples fall.
+         * @param percentile Percentile in [0, 100]
+         * @return Upper bound of the bucket containing the percentile, 0 when empty
+         */
+        [[nodiscard]] std::uint64_t GetValueAtPercentile(double percentile) const
+        {
+            if (count == 0)
+            {
+                return 0;
+            }
+
+            const auto clamped = std::clamp(percentile, 0.0, 100.0);
+            const auto target = std::max<std::uint64_t>(
+                1, static_cast<std::uint64_t>(clamped / 100.0 * static_cast<double>(count) + 0.5));
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < BucketCount; ++i)
+            {
+                seen += buckets[i];
+                if (seen >= target)
+                {
+                    return BucketUpperBound(i);
+                }
+            }
+            return BucketUpperBound(BucketCount - 1);
+        }
+
+        /**
+         * @brief Returns the raw bucket counts.
+         * @return Counts indexed by BucketIndex()
+         */
+        [[nodiscard]] const std::array<std::uint64_t, BucketCount> &GetBuckets() const
+        {
+            return buckets;
+        }
+
+    private:
+        friend class AtomicLatencyHistogram;
+
+        std::array<std::uint64_t, BucketCount> buckets{}; ///< Samples per bucket
+        std::uint64_t count = 0;                          ///< Total samples
+    };
+
+    /**
+     * @brief Thread-safe recorder producing LatencyHistogram snapshots.
+     */
+    class AtomicLatencyHistogram
+    {
+    public:
+        /**
+         * @brief Records one sample; safe to call from concurrent publishers.
+         * @param nanoseconds Sample value
+         */
+        void Record(std::uint64_t nanoseconds)
+        {
+            buckets[LatencyHistogram::BucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Copies the current counts.
+         * @return Histogram snapshot
+         */
+        [[nodiscard]] LatencyHistogram Snapshot() const
+        {
+            LatencyHistogram snapshot;
+            for (std::size_t i = 0; i < LatencyHistogram::BucketCount; ++i)
+            {
+                snapshot.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+                snapshot.count += snapshot.buckets[i];
+            }
+            return snapshot;
+        }
+
+        /**
+         * @brief Discards every recorded sample.
+         */
+        void Reset()
+        {
+            for (auto &bucket : buckets)
+            {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        std::array<std::atomic<std::uint64_t>, LatencyHistogram::BucketCount> buckets{}; ///< Samples per bucket
+    };
+
+    /**
+     * @brief Timing of a single subscribed handler.
+     */
+    struct HandlerStats
+    {
+        std::string name;                   ///< Callable type name as reported by the compiler
+        int priority = 0;                   ///< Subscription priority
+        std::uint64_t callCount = 0;        ///< Handler invocations (a batch counts once)
+        std::uint64_t totalNanoseconds = 0; ///< Time spent in the handler
+        std::uint64_t maxNanoseconds = 0;   ///< Slowest single invocation
+        LatencyHistogram latency;           ///< Invocation latency distribution
+    };
+
+    /**
+     * @brief Activity of one event type.
+     */
+    struct EventTypeStats
+    {
+        std::string name;                          ///< Event type name as reported by the compiler
+        std::uint64_t publishCount = 0;            ///< Events published since the last reset
+        std::uint64_t publishesLastFrame = 0;      ///< Events published during the last completed frame
+        std::uint64_t maxPublishesPerFrame = 0;    ///< Busiest completed frame
+        std::size_t subscriberCount = 0;           ///< Current subscribers of this exact type
+        std::uint64_t totalHandlerNanoseconds = 0; ///< Time spent in current subscribers
+        std::uint64_t maxHandlerNanoseconds = 0;   ///< Slowest single invocation among current subscribers
+        std::vector<HandlerStats> handlers;        ///< Current subscribers in dispatch order
+    };
+
+    /**
+     * @brief Instrumentation snapshot of an EventBus.
+     */
+    struct EventBusStats
+    {
+        std::uint64_t frameCount = 0;           ///< Frames completed since the last reset
+        std::vector<EventTypeStats> eventTypes; ///< One entry per event type seen by the bus
+
+        /**
+         * @brief Serializes the snapshot as JSON.
+         * @param indent Indentation width, or -1 for a compact single line
+         * @return JSON document; latencies are in nanoseconds and include p50/p90/p99/p99.9 per handler
+         */
+        [[nodiscard]] std::string ToJson(int indent = 2) const;
+    };
+
+    namespace Detail
+    {
+        /**
+         * @brief Live counters of one handler, updated by concurrent publishers.
+         */
+        struct HandlerCounters
+        {
+            /**
+             * @brief Records one invocation.
+             * @param nanoseconds Invocation duration
+             */
+            void Record(std::uint64_t nanoseconds)
+            {
+                callCount.fetch_add(1, std::memory_order_relaxed);
+                totalNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+                auto previous = maxNanoseconds.load(std::memory_order_relaxed);
+                while (previous < nanoseconds
+                       && !maxNanoseconds.compare_exchange_weak(previous, nanoseconds, std::memory_order_relaxed))
+                {
+                }
+                latency.Record(nanoseconds);
+            }
+
+            void Reset()
+            {
+                callCount.store(0, std::memory_order_relaxed);
+                totalNanoseconds.store(0, std::memory_order_relaxed);
+                maxNanoseconds.store(0, std::memory_order_relaxed);
+                latency.Reset();
+            }
+
+            std::atomic<std::uint64_t> callCount{ 0 };        ///< Invocations
+            std::atomic<std::uint64_t> totalNanoseconds{ 0 }; ///< Accumulated duration
+            std::atomic<std::uint64_t> maxNanoseconds{ 0 };   ///< Slowest invocation
+            AtomicLatencyHistogram latency;                   ///< Duration distribution
+        };
+
+        /**
+         * @brief Live publish counters of one event type.
+         */
+        struct EventTypeCounters
+        {
+            /**
+             * @brief Counts published events.
+             * @param count Number of events
+             */
+            void Record(std::uint64_t count)
+            {
+                publishCount.fetch_add(count, std::memory_order_relaxed);
+                publishesThisFrame.fetch_add(count, std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Closes the current frame.
+             */
+            void EndFrame()
+            {
+                const auto published = publishesThisFrame.exchange(0, std::memory_order_relaxed);
+                publishesLastFrame.store(published, std::memory_order_relaxed);
+                if (published > maxPublishesPerFrame.load(std::memory_order_relaxed))
+                {
+                    maxPublishesPerFrame.store(published, std::memory_order_relaxed);
+                }
+            }
+
+            void Reset()
+            {
+                publishCount.store(0, std::memory_order_relaxed);
+                publishesThisFrame.store(0, std::memory_order_relaxed);
+                publishesLastFrame.store(0, std::memory_order_relaxed);
+                maxPublishesPerFrame.store(0, std::memory_order_relaxed);
+            }
+
+            std::atomic<std::uint64_t> publishCount{ 0 };         ///< Events published since the last reset
+            std::atomic<std::uint64_t> publishesThisFrame{ 0 };   ///< Events published in the open frame
+            std::atomic<std::uint64_t> publishesLastFrame{ 0 };   ///< Events published in the last closed frame
+            std::atomic<std::uint64_t> maxPublishesPerFrame{ 0 }; ///< Busiest closed frame
+        };
+
+        /**
+         * @brief Extracts a readable type name from the compiler's function signature, without RTTI.
+         * @tparam T Type to name
+         * @return Name such as `KeyPressedEvent`; compiler-specific for lambdas
+         */
+        template<typename T> std::string_view TypeName()
+        {
+            const std::string_view signature = std::source_location::current().function_name();
+#if defined(_MSC_VER) && !defined(__clang__)
+            const auto begin = signature.find("TypeName<");
+            const auto end = signature.rfind(">(");
+            if (begin == std::string_view::npos || end == std::string_view::npos)
+            {
+                return signature;
+            }
+            return signature.substr(begin + 9, end - begin - 9);
+#else
+            const auto marker = signature.find("T = ");
+            if (marker == std::string_view::npos)
+            {
+                return signature;
+            }
+            const auto begin = marker + 4;
+            const auto end = signature.find_first_of(";]", begin);
+            return signature.substr(begin, end - begin);
+#endif
+        }
+    } // namespace Detail
+} // namespace Kappa
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Kappa
+{
+    /**
+     * @brief Type-erased interface used by Application to swap streams at the frame boundary.
+     */
+    class EventStreamBase
+    {
+    public:
+        /**
+         * @brief Virtual destructor for proper cleanup of derived classes.
+         */
+        virtual ~EventStreamBase() = default;
+
+        /**
+         * @brief Makes the events written since the last swap readable and starts a new write buffer.
+         */
+        virtual void Swap() = 0;
+    };
+
+    /**
+     * @brief Double-buffered per-frame stream of events that readers pull instead of subscribing to.
+     * @tparam TEvent Element type; any movable type, it needn't derive from Event
+     * @note Events pushed during frame N become readable, as one contiguous span, after Application::Run
+     *       swaps the stream at the end of frame N, and stay readable for all of frame N+1. Readers iterate
+     *       in their own OnUpdate with no callbacks or virtual calls, and both buffers keep their capacity,
+     *       so the steady state doesn't allocate. Not thread-safe: use from the main thread.
+     */
+    template<typename TEvent>
+        requires std::is_move_constructible_v<TEvent>
+    class EventStream final : public EventStreamBase
+    {
+    public:
+        /**
+         * @brief Appends an event to the write buffer.
+         * @param event Event to append
+         */
+        void Push(const TEvent &event)
+        {
+            writeBuffer.push_back(event);
+        }
+
+        /**
+         * @brief Constructs an event in place in the write buffer.
+         * @tparam Args Constructor argument types
+         * @param args Arguments forwarded to the event constructor
+         * @return The new event
+         */
+        template<typename... Args>
+            requires std::is_constructible_v<TEvent, Args...>
+        TEvent &Emplace(Args &&...args)
+        {
+            return writeBuffer.emplace_back(std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Returns the events of the previous frame.
+         * @return Contiguous view, valid until the next swap
+         */
+        [[nodiscard]] std::span<const TEvent> Read() const
+        {
+            return readBuffer;
+        }
+
+        /**
+         * @brief Returns the number of events written since the last swap.
+         * @return Pending event count
+         */
+        [[nodiscard]] std::size_t GetPendingCount() const
+        {
+            return writeBuffer.size();
+        }
+
+        void Swap() override
+        {
+            readBuffer.swap(writeBuffer);
+            writeBuffer.clear();
+        }
+
+        /**
+         * @brief Drops the pending and readable events.
+         */
+        void Clear()
+        {
+            writeBuffer.clear();
+            readBuffer.clear();
+        }
+
+    private:
+        std::vector<TEvent> writeBuffer; ///< Events of the current frame
+        std::vector<TEvent> readBuffer;  ///< Events of the previous frame
+    };
+} // namespace Kappa
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+
+namespace Kappa
+{
+    /**
+     * @brief Accumulator turning variable frame times into a whole number of fixed simulation steps.
+     * @note Each frame adds its duration to the accumulator and takes as many fixed steps as fit, so the
+     *       simulation advances at the same rate whatever the display rate. Catch-up is capped: when a frame
+     *       would need more than `maxSteps` steps, the excess is dropped instead of making the next frame
+     *       slower still (the "spiral of death"). The remainder gives the interpolation alpha for rendering
+     *       between the last two simulated states.
+     */
+    class FixedTimestep
+    {
+    public:
+        /**
+         * @brief Creates an accumulator.
+         * @param stepSize Seconds per step (e.g. 1/60)
+         * @param maxSteps Most steps taken in one frame
+         */
+        explicit FixedTimestep(float stepSize, int maxSteps = 8) : stepSize(stepSize), maxSteps(maxSteps)
+        {
+            assert(stepSize > 0.0f && maxSteps > 0);
+        }
+
+        /**
+         * @brief Adds a frame's duration and returns how many steps to run.
+         * @param frameTime Seconds since the previous frame
+         * @return Steps to run this frame, between 0 and the cap
+         */
+        int Advance(float frameTime)
+        {
+            accumulator += frameTime;
+
+            int steps = 0;
+            while (accumulator >= stepSize && steps < maxSteps)
+            {
+                accumulator -= stepSize;
+                steps++;
+            }
+
+            if (accumulator >= stepSize)
+            {
+                // Behind by more than the cap allows; keep only the fraction of a step
+                const auto remainder = std::fmod(accumulator, stepSize);
+                droppedSteps += static_cast<std::uint64_t>((accumulator - remainder) / stepSize + 0.5f);
+                accumulator = remainder;
+            }
+
+            stepCount += static_cast<std::uint64_t>(steps);
+            return steps;
+        }
+
+        /**
+         * @brief Returns how far the current time lies between the last step and the next one.
+         * @return Interpolation alpha in [0, 1)
+         */
+        [[nodiscard]] float GetAlpha() const
+        {
+            return accumulator / stepSize;
+        }
+
+        /**
+         * @brief Returns the fixed step duration.
+         * @return Seconds per step
+         */
+        [[nodiscard]] float GetStepSize() const
+        {
+            return stepSize;
+        }
+
+        /**
+         * @brief Returns the catch-up cap.
+         * @return Most steps taken in one frame
+         */
+        [[nodiscard]] int GetMaxSteps() const
+        {
+            return maxSteps;
+        }
+
+        /**
+         * @brief Returns the number of steps taken so far.
+         * @return Step count
+         */
+        [[nodiscard]] std::uint64_t GetStepCount() const
+        {
+            return stepCount;
+        }
+
+        /**
+         * @brief Returns the number of steps dropped because a frame exceeded the catch-up cap.
+         * @return Dropped step count; non-zero means the simulation ran slower than real time
+         */
+        [[nodiscard]] std::uint64_t GetDroppedSteps() const
+        {
+            return droppedSteps;
+        }
+
+        /**
+         * @brief Clears the accumulated time and the counters.
+         */
+        void Reset()
+        {
+            accumulator = 0.0f;
+            stepCount = 0;
+            droppedSteps = 0;
+        }
+
+    private:
+        float stepSize;                 ///< Seconds per step
+        int maxSteps;                   ///< Catch-up cap per frame
+        float accumulator = 0.0f;       ///< Simulated time owed, below one step after Advance()
+        std::uint64_t stepCount = 0;    ///< Steps taken
+        std::uint64_t droppedSteps = 0; ///< Steps skipped by the cap
+    };
+} // namespace Kappa
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Kappa
+{
+    /**
+     * @brief Frame-time statistics over the most recent frames.
+     * @note Frame time is measured end to end, from one EndFrame() to the next, so it includes the wait.
+     */
+    struct FramePacingStats
+    {
+        std::uint64_t targetFrameNanoseconds = 0; ///< Frame period requested, 0 when unlimited
+        double averageFrameNanoseconds = 0.0;     ///< Mean frame time over the window
+        double jitterNanoseconds = 0.0;           ///< Standard deviation of frame time over the window
+        std::uint64_t minFrameNanoseconds = 0;    ///< Shortest frame in the window
+        std::uint64_t maxFrameNanoseconds = 0;    ///< Longest frame in the window
+        std::size_t sampleCount = 0;              ///< Frames in the window
+        std::uint64_t frameCount = 0;             ///< Frames since the limiter was created
+        std::uint64_t missedFrames = 0;           ///< Frames that ended after their deadline
+
+        /**
+         * @brief Returns the frame rate implied by the average frame time.
+         * @return Frames per second over the window, 0 before any frame
+         */
+        [[nodiscard]] double GetFramesPerSecond() const
+        {
+            return averageFrameNanoseconds > 0.0 ? 1e9 / averageFrameNanoseconds : 0.0;
+        }
+    };
+
+    /**
+     * @brief Caps the frame rate with a hybrid sleep-then-spin wait on a monotonic clock.
+     * @note Sleeping alone overshoots by the OS timer granularity, and spinning alone burns a core. The
+     *       limiter sleeps until a safety margin before the deadline, then yields in a loop for the rest.
+     *       The margin adapts to the sleep overshoot actually observed. Deadlines advance by exactly one
+     *       period, so an early frame doesn't shift the ones after it; after a missed deadline the schedule
+     *       restarts from the current time instead of rushing to catch up.
+     */
+    class FrameLimiter
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr std::size_t WindowSize = 120; ///< Frames covered by GetStats()
+
+        /**
+         * @brief Creates a limiter.
+         * @param framesPerSecond Frame-rate cap; 0 or less only measures pacing
+         */
+        explicit FrameLimiter(double framesPerSecond = 0.0);
+
+        /**
+         * @brief Changes the frame-rate cap; the next deadline is one new period after the last frame.
+         * @param framesPerSecond Frame-rate cap; 0 or less removes the cap
+         */
+        void SetTargetFrameRate(double framesPerSecond);
+
+        /**
+         * @brief Returns the frame-rate cap.
+         * @return Frames per second, 0 when unlimited
+         */
+        [[nodiscard]] double GetTargetFrameRate() const
+        {
+            return targetFrameRate;
+        }
+
+        /**
+         * @brief Waits for the frame deadline, if limited, then records the frame time.
+         * @note Application::Run calls this once per frame, after presenting.
+         */
+        void EndFrame();
+
+        /**
+         * @brief Starts a new deadline schedule from now without recording a frame.
+         * @note Called after the application idled, so the idle gap isn't counted as a slow or missed frame.
+         */
+        void Restart();
+
+        /**
+         * @brief Returns pacing statistics over the last WindowSize frames.
+         * @return Statistics snapshot
+         */
+        [[nodiscard]] FramePacingStats GetStats() const;
+
+        /**
+         * @brief Returns the sleep margin currently left for spinning.
+         * @return Margin before the deadline at which sleeping stops
+         */
+        [[nodiscard]] Clock::duration GetSpinMargin() const
+        {
+            return spinMargin;
+        }
+
+    private:
+        /**
+         * @brief Sleeps until the margin before the deadline, then spins until the deadline.
+         */
+        void WaitUntil(Clock::time_point wakeTime);
+
+        double targetFrameRate = 0.0;                   ///< Frames per second, 0 when unlimited
+        Clock::duration period{};                       ///< Frame period, zero when unlimited
+        Clock::duration spinMargin;                     ///< Adaptive sleep safety margin
+        Clock::time_point deadline;                     ///< End of the current frame's time slot
+        Clock::time_point lastFrameEnd;                 ///< When the previous EndFrame() returned
+        std::array<std::uint64_t, WindowSize> frames{}; ///< Ring buffer of recent frame times in nanoseconds
+        std::size_t nextSample = 0;                     ///< Ring buffer write position
+        std::uint64_t frameCount = 0;                   ///< Frames recorded
+        std::uint64_t missedFrames = 0;                 ///< Deadlines missed
+    };
+} // namespace Kappa
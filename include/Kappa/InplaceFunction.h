@@ -0,0 +1,240 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Kappa
+{
+    /**
+     * @brief Default inline storage of an InplaceFunction, in bytes.
+     */
+    inline constexpr std::size_t DefaultInplaceFunctionCapacity = 4 * sizeof(void *);
+
+    template<typename Signature,
+        std::size_t Capacity = DefaultInplaceFunctionCapacity,
+        bool AllowHeapFallback = false>
+    class InplaceFunction;
+
+    /**
+     * @brief Move-only type-erased callable with fixed inline storage.
+     * @tparam R Return type
+     * @tparam Args Argument types
+     * @tparam Capacity Inline storage size in bytes
+     * @tparam AllowHeapFallback Whether callables that don't fit may be heap allocated
+     * @note Unlike std::function, a callable that doesn't fit is a compile error unless heap fallback is
+     *       opted into, and invoking costs exactly one indirect call.
+     */
+    template<typename R, typename... Args, std::size_t Capacity, bool AllowHeapFallback>
+    class InplaceFunction<R(Args...), Capacity, AllowHeapFallback>
+    {
+        static_assert(Capacity >= sizeof(void *), "InplaceFunction capacity must hold at least a pointer");
+
+    public:
+        /**
+         * @brief Checks whether a callable type is stored inline.
+         * @tparam TCallable Callable type
+         */
+        template<typename TCallable>
+        static constexpr bool StoresInline = sizeof(TCallable) <= Capacity
+                                             && alignof(TCallable) <= alignof(std::max_align_t)
+                                             && std::is_nothrow_move_constructible_v<TCallable>;
+
+        /**
+         * @brief Default constructor - creates an empty function.
+         */
+        InplaceFunction() noexcept = default;
+
+        /**
+         * @brief Constructs an empty function.
+         */
+        InplaceFunction(std::nullptr_t) noexcept
+        {
+        }
+
+        /**
+         * @brief Constructs from a callable.
+         * @tparam TCallable Callable type
+         * @param callable Callable to store
+         */
+        template<typename TCallable>
+            requires(!std::is_same_v<std::remove_cvref_t<TCallable>, InplaceFunction>)
+                    && std::is_invocable_r_v<R, std::decay_t<TCallable> &, Args...>
+        InplaceFunction(TCallable &&callable)
+        {
+            using Stored = std::decay_t<TCallable>;
+
+            if constexpr (StoresInline<Stored>)
+            {
+                ::new (static_cast<void *>(storage)) Stored(std::forward<TCallable>(callable));
+                invoker = &InvokeInline<Stored>;
+                manager = &ManageInline<Stored>;
+            }
+            else
+            {
+                static_assert(AllowHeapFallback,
+                    "Callable does not fit InplaceFunction inline storage; increase Capacity or allow heap fallback");
+
+                ::new (static_cast<void *>(storage)) Stored *(new Stored(std::forward<TCallable>(callable)));
+                invoker = &InvokeHeap<Stored>;
+                manager = &ManageHeap<Stored>;
+            }
+        }
+
+        /**
+         * @brief Destructor - destroys the stored callable.
+         */
+        ~InplaceFunction()
+        {
+            Reset();
+        }
+
+        /**
+         * @brief Deleted copy constructor - InplaceFunction is move-only.
+         */
+        InplaceFunction(const InplaceFunction &) = delete;
+
+        /**
+         * @brief Deleted copy assignment - InplaceFunction is move-only.
+         */
+        InplaceFunction &operator=(const InplaceFunction &) = delete;
+
+        /**
+         * @brief Move constructor.
+         * @param other Source function (left empty)
+         */
+        InplaceFunction(InplaceFunction &&other) noexcept
+        {
+            MoveFrom(other);
+        }
+
+        /**
+         * @brief Move assignment.
+         * @param other Source function (left empty)
+         * @return This function
+         */
+        InplaceFunction &operator=(InplaceFunction &&other) noexcept
+        {
+            if (this != &other)
+            {
+                Reset();
+                MoveFrom(other);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Destroys the stored callable.
+         * @return This function
+         */
+        InplaceFunction &operator=(std::nullptr_t) noexcept
+        {
+            Reset();
+            return *this;
+        }
+
+        /**
+         * @brief Invokes the stored callable.
+         * @param args Arguments forwarded to the callable
+         * @return Callable result
+         */
+        R operator()(Args... args) const
+        {
+            assert(invoker && "Invoking an empty InplaceFunction");
+            return invoker(storage, std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Checks if a callable is stored.
+         * @return True if not empty
+         */
+        explicit operator bool() const noexcept
+        {
+            return invoker != nullptr;
+        }
+
+    private:
+        enum class Operation
+        {
+            Move,
+            Destroy
+        };
+
+        using Invoker = R (*)(void *, Args &&...);
+        using Manager = void (*)(Operation, void *, void *) noexcept;
+
+        template<typename TCallable> static R Call(TCallable &callable, Args &&...args)
+        {
+            if constexpr (std::is_void_v<R>)
+            {
+                std::invoke(callable, std::forward<Args>(args)...);
+            }
+            else
+            {
+                return std::invoke(callable, std::forward<Args>(args)...);
+            }
+        }
+
+        template<typename TCallable> static R InvokeInline(void *data, Args &&...args)
+        {
+            return Call(*std::launder(static_cast<TCallable *>(data)), std::forward<Args>(args)...);
+        }
+
+        template<typename TCallable> static R InvokeHeap(void *data, Args &&...args)
+        {
+            return Call(**std::launder(static_cast<TCallable **>(data)), std::forward<Args>(args)...);
+        }
+
+        template<typename TCallable>
+        static void ManageInline(Operation operation, void *destination, void *source) noexcept
+        {
+            auto *callable = std::launder(static_cast<TCallable *>(source));
+            if (operation == Operation::Move)
+            {
+                ::new (destination) TCallable(std::move(*callable));
+            }
+            callable->~TCallable();
+        }
+
+        template<typename TCallable>
+        static void ManageHeap(Operation operation, void *destination, void *source) noexcept
+        {
+            auto *callable = *std::launder(static_cast<TCallable **>(source));
+            if (operation == Operation::Move)
+            {
+                ::new (destination) TCallable *(callable);
+            }
+            else
+            {
+                delete callable;
+            }
+        }
+
+        void MoveFrom(InplaceFunction &other) noexcept
+        {
+            if (other.manager)
+            {
+                other.manager(Operation::Move, storage, other.storage);
+                invoker = std::exchange(other.invoker, nullptr);
+                manager = std::exchange(other.manager, nullptr);
+            }
+        }
+
+        void Reset() noexcept
+        {
+            if (manager)
+            {
+                manager(Operation::Destroy, nullptr, storage);
+                invoker = nullptr;
+                manager = nullptr;
+            }
+        }
+
+        alignas(std::max_align_t) mutable std::byte storage[Capacity]; ///< Inline callable (or heap pointer)
+        Invoker invoker = nullptr;                                      ///< Calls the stored callable
+        Manager manager = nullptr;                                      ///< Moves or destroys the stored callable
+    };
+} // namespace Kappa
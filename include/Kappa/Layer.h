@@ -1,11 +1,37 @@
 #pragma once
 
 #include "Event.h"
+#include "RenderSnapshot.h"
+#include "Subscription.h"
+
+#include <span>
+#include <vector>
 
 namespace Kappa
 {
+    namespace Detail
+    {
+        /**
+         * @brief Object whose address identifies a resource type in layer access declarations.
+         */
+        template<typename TResource> inline constexpr char LayerResourceTag = 0;
+    } // namespace Detail
+
+    /**
+     * @brief One piece of shared data a layer's OnUpdate() reads or writes.
+     */
+    struct LayerResourceAccess
+    {
+        const void *resource = nullptr; ///< Identity: a type tag or the address of the data itself
+        bool write = false;             ///< Writes conflict with every other access to the same resource
+    };
+
     /**
      * @brief Base class for application layers.
+     * @note A layer that declares its data access in its constructor (Reads(), Writes() or
+     *       DeclareNoSharedState()) may have OnUpdate() run on a worker thread, concurrently with layers it
+     *       doesn't conflict with. Layers that declare nothing update on the main thread, ordered against
+     *       every other layer, as before.
      */
     class Layer
     {
@@ -31,11 +57,114 @@ namespace Kappa
         {
         }
 
+        /**
+         * @brief Called zero or more times per frame, before OnUpdate(), when fixed-step mode is enabled.
+         * @param timestep Constant step duration, ApplicationSpecification::fixedTimestep
+         * @note Put simulation here so its results don't depend on the display rate; render between the
+         *       last two steps with Application::GetInterpolationAlpha().
+         */
+        virtual void OnFixedUpdate([[maybe_unused]] float timestep)
+        {
+        }
+
         /**
          * @brief Called every frame to render the layer.
+         * @note With ApplicationSpecification::pipelinedRendering this runs while the next OnUpdate() is in
+         *       progress on the simulation thread, so it may only read RenderSnapshot state.
          */
         virtual void OnRender()
         {
         }
+
+        /**
+         * @brief Checks whether the layer declared its data access.
+         * @return True if OnUpdate() may run on a worker thread
+         */
+        [[nodiscard]] bool HasDeclaredAccess() const
+        {
+            return accessDeclared;
+        }
+
+        /**
+         * @brief Returns the declared data access.
+         * @return Reads and writes in declaration order
+         */
+        [[nodiscard]] std::span<const LayerResourceAccess> GetResourceAccesses() const
+        {
+            return resourceAccesses;
+        }
+
+    protected:
+        /**
+         * @brief Declares that OnUpdate() reads shared data of a type.
+         * @tparam TResource Type standing for the data, e.g. a component or the system owning it
+         * @note Call from the constructor. Concurrent readers of a resource don't wait for each other.
+         */
+        template<typename TResource> void Reads()
+        {
+            Reads(&Detail::LayerResourceTag<TResource>);
+        }
+
+        /**
+         * @brief Declares that OnUpdate() writes shared data of a type.
+         * @tparam TResource Type standing for the data
+         * @note Call from the constructor. A writer is ordered by stack position against every other
+         *       layer that reads or writes the resource.
+         */
+        template<typename TResource> void Writes()
+        {
+            Writes(&Detail::LayerResourceTag<TResource>);
+        }
+
+        /**
+         * @brief Declares that OnUpdate() reads a specific shared object.
+         * @param resource Address of the object
+         */
+        void Reads(const void *resource)
+        {
+            resourceAccesses.push_back({ resource, false });
+            accessDeclared = true;
+        }
+
+        /**
+         * @brief Declares that OnUpdate() writes a specific shared object.
+         * @param resource Address of the object
+         */
+        void Writes(const void *resource)
+        {
+            resourceAccesses.push_back({ resource, true });
+            accessDeclared = true;
+        }
+
+        /**
+         * @brief Declares that OnUpdate() touches no data shared with other layers.
+         * @note Only thread-safe framework calls (EventBus::Publish, EventChannel pushes, Application::Get)
+         *       are allowed from a layer updating on a worker thread.
+         */
+        void DeclareNoSharedState()
+        {
+            accessDeclared = true;
+        }
+
+        /**
+         * @brief Registers state the layer hands from OnUpdate() to OnRender().
+         * @param snapshot Snapshot member of the layer, published by Application::Run after every update
+         * @note Call from the constructor.
+         */
+        void AddRenderSnapshot(RenderSnapshotBase &snapshot)
+        {
+            renderSnapshots.push_back(&snapshot);
+        }
+
+    private:
+        friend class Application;
+        friend class EventBus;
+        friend class StaticEventBusBase;
+        friend class TaskScheduler;
+
+        std::vector<Subscription> subscriptions;           ///< Event subscriptions tied to this layer's lifetime
+        std::vector<LayerResourceAccess> resourceAccesses; ///< Data OnUpdate() reads or writes
+        std::vector<RenderSnapshotBase *> renderSnapshots; ///< Snapshots published after every update
+        bool accessDeclared = false;                       ///< Whether OnUpdate() may leave the main thread
     };
 } // namespace Kappa
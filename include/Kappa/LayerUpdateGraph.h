@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Layer.h"
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace Kappa
+{
+    class Application;
+
+    /**
+     * @brief Dependency graph over the layer stack, used to run independent OnUpdate() calls concurrently.
+     * @note Layer j depends on an earlier layer i when either declared no data access, or when one writes a
+     *       resource the other reads or writes. The graph is built once per change of the layer stack;
+     *       each frame, layers whose dependencies have finished run on the thread pool, while layers
+     *       without declarations run on the calling (main) thread, which helps with pool work when idle.
+     *       Updating allocates no graph state.
+     */
+    class LayerUpdateGraph
+    {
+    public:
+        /**
+         * @brief Rebuilds the graph for a layer stack.
+         * @param layers Layers in stack order; must outlive their use by Update()
+         */
+        void Build(std::span<const std::unique_ptr<Layer>> layers);
+
+        /**
+         * @brief Calls OnUpdate() on every layer, respecting the dependencies.
+         * @param timestep Seconds passed to OnUpdate()
+         * @param pool Workers for layers that declared their data access
+         * @param application Made current on the workers while they update layers, may be null
+         * @note Returns once every layer has updated. When an OnUpdate() throws, on any thread, layers that have
+         *       not started are skipped and the first exception is rethrown here once no layer is still running.
+         */
+        void Update(float timestep, ThreadPool &pool, Application *application);
+
+        /**
+         * @brief Returns the number of layers in the graph.
+         * @return Layer count
+         */
+        [[nodiscard]] std::size_t GetLayerCount() const
+        {
+            return nodes.size();
+        }
+
+        /**
+         * @brief Checks whether one layer waits for another.
+         * @param later Stack index of the dependent layer
+         * @param earlier Stack index of the layer it may depend on
+         * @return True if a direct dependency exists
+         */
+        [[nodiscard]] bool DependsOn(std::size_t later, std::size_t earlier) const;
+
+        /**
+         * @brief Returns the length of the longest dependency chain.
+         * @return Layers that must update one after another; equal to the layer count when nothing overlaps
+         */
+        [[nodiscard]] std::size_t GetCriticalPathLength() const
+        {
+            return criticalPathLength;
+        }
+
+    private:
+        /**
+         * @brief One layer and the layers waiting for it.
+         */
+        struct Node
+        {
+            Layer *layer = nullptr;                ///< Layer to update
+            std::vector<std::uint32_t> successors; ///< Later layers depending on this one
+            std::uint32_t dependencyCount = 0;     ///< Earlier layers this one waits for
+            bool mainThread = false;               ///< Declared no access, so stays on the main thread
+        };
+
+        /**
+         * @brief Updates one layer and releases the layers waiting for it.
+         */
+        void RunNode(std::uint32_t index);
+
+        /**
+         * @brief Hands a layer whose dependencies finished to the pool or to the main thread.
+         */
+        void MakeReady(std::uint32_t index);
+
+        std::vector<Node> nodes;                               ///< Layers in stack order
+        std::unique_ptr<std::atomic<std::uint32_t>[]> pending; ///< Unfinished dependencies per layer this frame
+        std::atomic<std::size_t> remaining{ 0 };               ///< Layers not yet updated this frame
+        std::mutex mainThreadMutex;                            ///< Guards mainThreadReady and frameError
+        std::vector<std::uint32_t> mainThreadReady;            ///< Main-thread layers ready to update
+        std::size_t criticalPathLength = 0;                    ///< Longest dependency chain
+        bool hasWorkerLayers = false;                          ///< Some layer may update off the main thread
+        float frameTimestep = 0.0f;                            ///< Timestep of the running Update()
+        ThreadPool *framePool = nullptr;                       ///< Pool of the running Update()
+        Application *frameApplication = nullptr;               ///< Application of the running Update()
+        std::exception_ptr frameError;                         ///< First exception thrown this frame
+        std::atomic<bool> frameFailed{ false };                ///< Set once frameError holds an exception
+    };
+} // namespace Kappa
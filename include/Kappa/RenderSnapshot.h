@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace Kappa
+{
+    /**
+     * @brief Type-erased base of RenderSnapshot, so layers can register snapshots of any state type.
+     */
+    class RenderSnapshotBase
+    {
+    public:
+        virtual ~RenderSnapshotBase() = default;
+
+        /**
+         * @brief Makes the state written since the last publish readable.
+         * @note Called by Application::Run once per frame, while no layer updates or renders.
+         */
+        virtual void Publish() = 0;
+    };
+
+    /**
+     * @brief Double-buffered state a layer hands from OnUpdate() to OnRender().
+     * @tparam TState State type; default constructible and cheap enough to keep twice
+     * @note OnUpdate() fills Write() and OnRender() draws Read(). The buffers trade places when the frame is
+     *       published, so with ApplicationSpecification::pipelinedRendering the next update can fill one
+     *       buffer on the simulation thread while the main thread renders the other. The write buffer holds
+     *       the state from two publishes ago; overwrite every field each frame. Register the snapshot with
+     *       Layer::AddRenderSnapshot().
+     */
+    template<typename TState> class RenderSnapshot : public RenderSnapshotBase
+    {
+    public:
+        /**
+         * @brief Returns the buffer being filled for the next publish.
+         * @return Write buffer; only touch it from OnUpdate() or OnFixedUpdate()
+         */
+        [[nodiscard]] TState &Write()
+        {
+            return buffers[1 - front];
+        }
+
+        /**
+         * @brief Returns the most recently published state.
+         * @return Read buffer; stays unchanged until the next publish
+         */
+        [[nodiscard]] const TState &Read() const
+        {
+            return buffers[front];
+        }
+
+        void Publish() override
+        {
+            front = 1 - front;
+        }
+
+    private:
+        std::array<TState, 2> buffers{}; ///< Read and write buffers
+        std::size_t front = 0;           ///< Index of the read buffer
+    };
+} // namespace Kappa
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Kappa::Detail
+{
+    /**
+     * @brief Per-thread announcement of the epoch a reader pinned.
+     * @note Records are registered once per thread, reused after the thread exits and never freed, so the
+     *       list only grows with the peak number of reading threads.
+     */
+    struct EpochRecord
+    {
+        std::atomic<std::uint64_t> pinned{ 0 }; ///< Epoch pinned by the owning thread, 0 while it isn't reading
+        std::atomic<bool> inUse{ false };       ///< Claimed by a live thread
+        EpochRecord *next = nullptr;            ///< Next registered record, fixed once published
+    };
+
+    inline std::atomic<std::uint64_t> globalEpoch{ 1 };               ///< Advanced by writers reclaiming snapshots
+    constinit inline thread_local EpochRecord *epochRecord = nullptr; ///< Record of the calling thread, if claimed
+    constinit inline thread_local std::uint32_t epochDepth = 0;       ///< Nesting of ReadGuards on this thread
+
+    /**
+     * @brief Claims a record for the calling thread, released again when the thread exits.
+     * @return The calling thread's record
+     */
+    EpochRecord *AcquireEpochRecord();
+
+    /**
+     * @brief Advances the global epoch if every reading thread has pinned the current one.
+     * @return The global epoch after the attempt
+     */
+    std::uint64_t TryAdvanceEpoch();
+
+    /**
+     * @brief Pins the calling thread's epoch so snapshots it loads stay alive until the guard ends.
+     * @note Only the outermost guard on a thread writes its record, a line no other thread writes. The pin
+     *       and the snapshot loads are sequentially consistent, so a writer that retires a snapshot after
+     *       the pin either sees the pin or the reader sees the new snapshot. Nested guards (handlers
+     *       publishing) only bump a thread-local depth.
+     */
+    class ReadGuard
+    {
+    public:
+        ReadGuard()
+        {
+            if (epochDepth++ == 0)
+            {
+                auto *record = epochRecord ? epochRecord : AcquireEpochRecord();
+                record->pinned.store(globalEpoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+            }
+        }
+
+        ~ReadGuard()
+        {
+            if (--epochDepth == 0)
+            {
+                epochRecord->pinned.store(0, std::memory_order_release);
+            }
+        }
+
+        ReadGuard(const ReadGuard &) = delete;
+        ReadGuard &operator=(const ReadGuard &) = delete;
+    };
+
+    /**
+     * @brief Snapshots replaced by writers, freed once no reader can still be using them.
+     * @note A snapshot retired in epoch E is freed when the global epoch reaches E + 2: the epoch only
+     *       advances past a reader once it has unpinned, so every reader that could have loaded the
+     *       snapshot is gone. Not thread-safe; owners retire under their writer lock.
+     */
+    class RetiredList
+    {
+    public:
+        RetiredList() = default;
+
+        RetiredList(const RetiredList &) = delete;
+        RetiredList &operator=(const RetiredList &) = delete;
+
+        /**
+         * @brief Retires a snapshot that readers can no longer reach, then frees what has become safe.
+         * @param snapshot Replaced snapshot; null is ignored
+         */
+        void Retire(std::shared_ptr<const void> snapshot)
+        {
+            if (!snapshot)
+            {
+                return;
+            }
+
+            // Sequentially consistent like the unlinking store, so the tag can't predate a reader that saw it
+            entries.push_back({ globalEpoch.load(std::memory_order_seq_cst), std::move(snapshot) });
+            Collect();
+        }
+
+        /**
+         * @brief Frees every retired snapshot no reader can still be using.
+         */
+        void Collect()
+        {
+            const auto epoch = TryAdvanceEpoch();
+            std::erase_if(entries, [epoch](const Entry &entry) { return entry.epoch + 2 <= epoch; });
+        }
+
+        /**
+         * @brief Returns the number of snapshots waiting to be freed.
+         * @return Retired snapshot count
+         */
+        [[nodiscard]] std::size_t GetSize() const
+        {
+            return entries.size();
+        }
+
+    private:
+        struct Entry
+        {
+            std::uint64_t epoch;                  ///< Global epoch when the snapshot was retired
+            std::shared_ptr<const void> snapshot; ///< Keeps the snapshot alive until it is safe to free
+        };
+
+        std::vector<Entry> entries; ///< Retired snapshots, oldest first
+    };
+
+    /**
+     * @brief Read-copy-update pointer: readers load a raw pointer, writers replace and retire it.
+     * @tparam T Pointee type
+     * @note Load() is a single atomic load with no reference count or lock, and must run under a ReadGuard.
+     *       It is sequentially consistent to pair with the ReadGuard pin, which costs the same plain load
+     *       as acquire on x86 and ARMv8. Writers own the current value through Get() and Store(),
+     *       serialized by the owner.
+     */
+    template<typename T> class SnapshotPtr
+    {
+    public:
+        SnapshotPtr() = default;
+
+        /**
+         * @brief Constructs with an initial value.
+         * @param initial Initial snapshot
+         */
+        explicit SnapshotPtr(std::shared_ptr<T> initial) : current(std::move(initial)), published(current.get())
+        {
+        }
+
+        SnapshotPtr(const SnapshotPtr &) = delete;
+        SnapshotPtr &operator=(const SnapshotPtr &) = delete;
+
+        /**
+         * @brief Loads the published snapshot for reading.
+         * @return Current snapshot, valid until the enclosing ReadGuard ends
+         */
+        [[nodiscard]] const T *Load() const
+        {
+            return published.load(std::memory_order_seq_cst);
+        }
+
+        /**
+         * @brief Returns the current snapshot to a writer.
+         * @return Owning pointer to the current value
+         */
+        [[nodiscard]] const std::shared_ptr<T> &Get() const
+        {
+            return current;
+        }
+
+        /**
+         * @brief Publishes a new snapshot and retires the previous one.
+         * @param desired New value
+         * @param retired List that frees the previous value once readers are done with it
+         */
+        void Store(std::shared_ptr<T> desired, RetiredList &retired)
+        {
+            published.store(desired.get(), std::memory_order_seq_cst);
+            retired.Retire(std::exchange(current, std::move(desired)));
+        }
+
+    private:
+        std::shared_ptr<T> current;            ///< Owner of the published snapshot; writers only
+        std::atomic<T *> published{ nullptr }; ///< Snapshot read by publishers
+    };
+} // namespace Kappa::Detail
@@ -0,0 +1,562 @@
+#pragma once
+
+#include "Event.h"
+#include "EventBus.h"
+#include "InplaceFunction.h"
+#include "Layer.h"
+#include "Subscription.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Kappa
+{
+    namespace Detail
+    {
+        /**
+         * @brief Returns the position of a type in a type list.
+         * @tparam T Type to look up
+         * @tparam Ts Type list
+         * @return Index of the first T in Ts, or sizeof...(Ts) if absent
+         */
+        template<typename T, typename... Ts> consteval std::size_t TypeListIndex()
+        {
+            constexpr bool matches[] = { std::is_same_v<T, Ts>..., false };
+            for (std::size_t i = 0; i < sizeof...(Ts); ++i)
+            {
+                if (matches[i])
+                {
+                    return i;
+                }
+            }
+            return sizeof...(Ts);
+        }
+
+        /**
+         * @brief Counts the occurrences of a type in a type list.
+         */
+        template<typename T, typename... Ts> consteval std::size_t TypeListCount()
+        {
+            return (std::size_t{ 0 } + ... + static_cast<std::size_t>(std::is_same_v<T, Ts>));
+        }
+
+        /**
+         * @brief Satisfied when no type appears twice in the list.
+         */
+        template<typename... Ts>
+        concept DistinctTypes = ((TypeListCount<Ts, Ts...>() == 1) && ...);
+    } // namespace Detail
+
+    /**
+     * @brief Type-erased interface Application uses to drive an installed StaticEventBus.
+     */
+    class StaticEventBusBase : public SubscriptionHost
+    {
+    public:
+        /**
+         * @brief Delivers every event queued with Enqueue() before this call.
+         */
+        virtual void DispatchQueued() = 0;
+
+    protected:
+        /**
+         * @brief Ties a subscription to a layer's lifetime.
+         */
+        static void KeepWithLayer(Layer &owner, Subscription &&subscription)
+        {
+            owner.subscriptions.push_back(std::move(subscription));
+        }
+    };
+
+    /**
+     * @brief Event bus for a fixed set of event types known at compile time.
+     * @tparam THasFallback Whether events not in TEvents are forwarded to a dynamic EventBus
+     * @tparam TEvents Event types handled by this bus (each must derive from Event, no duplicates)
+     * @note Keeps one typed handler vector per event type in a tuple, so finding the handlers of an event is
+     *       a compile-time `std::get` with no type index, table load or epoch pin, and the
+     *       whole dispatch loop can inline into the publisher. Use it through one of two aliases:
+     *       StaticEventBus stands alone and rejects unlisted event types at compile time, while
+     *       StaticEventBusWithFallback is layered on top of a dynamic EventBus and forwards them to it.
+     *       Unlike EventBus this bus is not thread-safe: subscribe, publish and unsubscribe from the main
+     *       thread (use EventChannel to reach it from workers). Handlers may subscribe and unsubscribe while
+     *       an event is being dispatched; additions take effect with the next event and removals immediately.
+     */
+    template<bool THasFallback, typename... TEvents>
+        requires(std::is_base_of_v<Event, TEvents> && ...) && Detail::DistinctTypes<TEvents...>
+    class BasicStaticEventBus final : public StaticEventBusBase
+    {
+    public:
+        /**
+         * @brief Whether events not in TEvents are forwarded to a fallback bus instead of failing to compile.
+         */
+        static constexpr bool HasFallback = THasFallback;
+
+        /**
+         * @brief Inline storage available to each handler callable, in bytes.
+         */
+        static constexpr std::size_t HandlerCapacity = EventBus::HandlerCapacity;
+
+        /**
+         * @brief Whether TEvent is one of the statically dispatched event types.
+         */
+        template<typename TEvent>
+        static constexpr bool Handles = Detail::TypeListIndex<TEvent, TEvents...>() < sizeof...(TEvents);
+
+        /**
+         * @brief Constructs a standalone bus.
+         */
+        BasicStaticEventBus()
+            requires(!THasFallback)
+        = default;
+
+        /**
+         * @brief Constructs a bus layered on top of a dynamic one.
+         * @param fallback Dynamic bus receiving events that are not in TEvents; must outlive this bus
+         */
+        explicit BasicStaticEventBus(EventBus &fallback)
+            requires THasFallback
+            : fallback(&fallback)
+        {
+        }
+
+        BasicStaticEventBus(const BasicStaticEventBus &) = delete;
+        BasicStaticEventBus &operator=(const BasicStaticEventBus &) = delete;
+
+        /**
+         * @brief Subscribes to events of a specific type.
+         * @tparam TEvent Event type (must derive from Event)
+         * @tparam TCallback Callable invocable with `const TEvent &`, returning void or bool
+         * @param callback Callback function; returning true marks the event handled and stops dispatch
+         * @param priority Higher priorities run first; equal priorities run in subscription order
+         * @return Token that removes the handler when destroyed
+         * @note Without a fallback bus, subscribing to a type that is not in TEvents doesn't compile.
+         */
+        template<typename TEvent, typename TCallback>
+            requires std::is_base_of_v<Event, TEvent> && std::is_invocable_v<std::decay_t<TCallback> &, const TEvent &>
+        [[nodiscard]] Subscription Subscribe(TCallback &&callback, int priority = 0)
+        {
+            static_assert(THasFallback || Handles<TEvent>,
+                "Event type is not listed in this StaticEventBus and it has no fallback bus");
+            if constexpr (!Handles<TEvent>)
+            {
+                return fallback->template Subscribe<TEvent>(std::forward<TCallback>(callback), priority);
+            }
+            else
+            {
+                using Result = std::invoke_result_t<std::decay_t<TCallback> &, const TEvent &>;
+                static_assert(std::is_void_v<Result> || std::is_convertible_v<Result, bool>,
+                    "Event handlers must return void or a handled flag convertible to bool");
+
+                auto adapter = [callback = std::forward<TCallback>(callback)](const TEvent &event) mutable {
+                    if constexpr (std::is_void_v<Result>)
+                    {
+                        std::invoke(callback, event);
+                        return false;
+                    }
+                    else
+                    {
+                        return static_cast<bool>(std::invoke(callback, event));
+                    }
+                };
+
+                const auto id = nextId++;
+                GetChannel<TEvent>().Add(Callback<TEvent>(std::move(adapter)), priority, id);
+                return MakeSubscription(static_cast<std::uint32_t>(IndexOf<TEvent>), id);
+            }
+        }
+
+        /**
+         * @brief Subscribes to events of a specific type for the lifetime of a layer.
+         * @tparam TEvent Event type (must derive from Event)
+         * @tparam TCallback Callable invocable with `const TEvent &`, returning void or bool
+         * @param owner Layer that keeps the subscription; it is removed when the layer is destroyed
+         * @param callback Callback function; returning true marks the event handled and stops dispatch
+         * @param priority Higher priorities run first; equal priorities run in subscription order
+         * @note The bus must outlive the layer.
+         */
+        template<typename TEvent, typename TCallback>
+            requires std::is_base_of_v<Event, TEvent> && std::is_invocable_v<std::decay_t<TCallback> &, const TEvent &>
+        void Subscribe(Layer &owner, TCallback &&callback, int priority = 0)
+        {
+            KeepWithLayer(owner, Subscribe<TEvent>(std::forward<TCallback>(callback), priority));
+        }
+
+        /**
+         * @brief Publishes an event to subscribers in priority order until one handles it.
+         * @tparam TEvent Event type (must derive from Event)
+         * @param event Event to publish
+         * @return True if a handler marked the event handled
+         * @note Walks the DerivedEvent parent chain like EventBus::Publish, visiting the listed types at
+         *       compile time. If the chain contains types that aren't listed and the event wasn't handled,
+         *       the event is then published to the fallback bus. Without a fallback bus, publishing an event
+         *       whose chain lists no type doesn't compile.
+         */
+        template<typename TEvent>
+            requires std::is_base_of_v<Event, TEvent>
+        bool Publish(const TEvent &event)
+        {
+            static_assert(THasFallback || ChainHasStatic<TEvent>(),
+                "Event type is not listed in this StaticEventBus and it has no fallback bus");
+            if (DispatchChain<TEvent>(event))
+            {
+                return true;
+            }
+
+            if constexpr (THasFallback && !ChainIsStatic<TEvent>())
+            {
+                return fallback->Publish(event);
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        /**
+         * @brief Publishes a contiguous batch of events of one type.
+         * @tparam TEvent Event type (must derive from Event)
+         * @param events Events to publish
+         * @note Statically dispatched events are delivered one at a time; unlisted types go to the fallback
+         *       bus as a single batch.
+         */
+        template<typename TEvent>
+            requires std::is_base_of_v<Event, TEvent>
+        void PublishBatch(std::span<const TEvent> events)
+        {
+            static_assert(THasFallback || ChainHasStatic<TEvent>(),
+                "Event type is not listed in this StaticEventBus and it has no fallback bus");
+            if constexpr (!ChainHasStatic<TEvent>())
+            {
+                fallback->PublishBatch(events);
+            }
+            else
+            {
+                for (const auto &event : events)
+                {
+                    Publish(event);
+                }
+            }
+        }
+
+        /**
+         * @brief Queues an event for deferred delivery by DispatchQueued().
+         * @tparam TEvent Event type (must derive from Event)
+         * @tparam Args Constructor argument types
+         * @param args Arguments forwarded to the event constructor
+         * @note Unlisted types are queued on the fallback bus and delivered by its own DispatchQueued().
+         *       Without a fallback bus they don't compile.
+         */
+        template<typename TEvent, typename... Args>
+            requires std::is_base_of_v<Event, TEvent> && std::is_constructible_v<TEvent, Args...>
+        void Enqueue(Args &&...args)
+        {
+            static_assert(THasFallback || Handles<TEvent>,
+                "Event type is not listed in this StaticEventBus and it has no fallback bus");
+            if constexpr (!Handles<TEvent>)
+            {
+                fallback->template Enqueue<TEvent>(std::forward<Args>(args)...);
+            }
+            else
+            {
+                GetChannel<TEvent>().pending.emplace_back(std::forward<Args>(args)...);
+            }
+        }
+
+        /**
+         * @brief Delivers every statically dispatched event queued before this call, in TEvents order.
+         * @note Events queued by handlers during dispatch are delivered by the next call. Does not drain the
+         *       fallback bus.
+         */
+        void DispatchQueued() override
+        {
+            std::apply([](auto &...channels) { (channels.pending.swap(channels.dispatching), ...); }, channels);
+            std::apply([this](auto &...channels) { (DispatchQueue(channels), ...); }, channels);
+        }
+
+        /**
+         * @brief Clears all statically dispatched subscribers.
+         * @note Outstanding Subscription tokens become stale and are ignored when destroyed. The fallback bus
+         *       is left untouched.
+         */
+        void Clear()
+        {
+            std::apply([](auto &...channels) { (channels.Clear(), ...); }, channels);
+        }
+
+        /**
+         * @brief Returns the number of handlers subscribed to a listed event type.
+         * @tparam TEvent Event type in TEvents
+         * @return Live handler count
+         */
+        template<typename TEvent>
+            requires Handles<TEvent>
+        [[nodiscard]] std::size_t GetSubscriberCount() const
+        {
+            const auto &channel = std::get<IndexOf<TEvent>>(channels);
+            return static_cast<std::size_t>(std::count_if(channel.entries.begin(),
+                       channel.entries.end(),
+                       [](const auto &entry) { return entry.alive; })) +
+                   channel.added.size();
+        }
+
+        /**
+         * @brief Returns the fallback bus.
+         * @return Fallback bus, or nullptr for a standalone bus
+         */
+        [[nodiscard]] EventBus *GetFallbackBus() const
+        {
+            return fallback;
+        }
+
+    private:
+        template<typename TEvent>
+        static constexpr std::size_t IndexOf = Detail::TypeListIndex<TEvent, TEvents...>();
+
+        template<typename TEvent> using Callback = InplaceFunction<bool(const TEvent &), HandlerCapacity>;
+
+        /**
+         * @brief Handler vector and deferred queues of one event type.
+         * @tparam TEvent Event type
+         */
+        template<typename TEvent> struct Channel
+        {
+            /**
+             * @brief Marks a dispatch in progress and applies deferred changes when the outermost one ends.
+             */
+            class DispatchScope
+            {
+            public:
+                explicit DispatchScope(Channel &channel) : channel(channel)
+                {
+                    ++channel.dispatchDepth;
+                }
+
+                ~DispatchScope()
+                {
+                    if (--channel.dispatchDepth == 0 && channel.dirty)
+                    {
+                        channel.Flush();
+                    }
+                }
+
+                DispatchScope(const DispatchScope &) = delete;
+                DispatchScope &operator=(const DispatchScope &) = delete;
+
+            private:
+                Channel &channel; ///< Channel being dispatched
+            };
+
+            struct Entry
+            {
+                Callback<TEvent> callback; ///< User callback, kept intact until compaction
+                int priority;              ///< Dispatch priority, fixed at subscribe time
+                std::uint32_t id;          ///< Subscription id matched by Remove()
+                bool alive = true;         ///< Cleared when removed during dispatch
+            };
+
+            /**
+             * @brief Calls handlers in priority order until one reports the event handled.
+             * @note Handlers added meanwhile are held back so `entries` never reallocates under a running
+             *       callback. Handlers removed meanwhile are only marked dead, since the removing handler
+             *       may be the one running; they are destroyed once the outermost dispatch returns, or
+             *       unwinds when a handler throws.
+             */
+            bool Dispatch(const TEvent &event)
+            {
+                DispatchScope scope(*this);
+                bool handled = false;
+                const auto count = entries.size();
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    auto &entry = entries[i];
+                    if (entry.alive && entry.callback(event))
+                    {
+                        handled = true;
+                        break;
+                    }
+                }
+                return handled;
+            }
+
+            void Add(Callback<TEvent> &&callback, int priority, std::uint32_t id)
+            {
+                if (dispatchDepth > 0)
+                {
+                    added.push_back(Entry{ std::move(callback), priority, id, true });
+                    dirty = true;
+                    return;
+                }
+                Insert(Entry{ std::move(callback), priority, id, true });
+            }
+
+            void Remove(std::uint32_t id)
+            {
+                const auto matches = [id](const Entry &entry) { return entry.id == id; };
+                if (std::erase_if(added, matches) > 0)
+                {
+                    return;
+                }
+
+                const auto it = std::find_if(entries.begin(), entries.end(), matches);
+                if (it == entries.end())
+                {
+                    return;
+                }
+
+                if (dispatchDepth > 0)
+                {
+                    it->alive = false;
+                    dirty = true;
+                }
+                else
+                {
+                    entries.erase(it);
+                }
+            }
+
+            void Clear()
+            {
+                added.clear();
+                if (dispatchDepth > 0)
+                {
+                    for (auto &entry : entries)
+                    {
+                        entry.alive = false;
+                    }
+                    dirty = true;
+                }
+                else
+                {
+                    entries.clear();
+                }
+            }
+
+            void Insert(Entry &&entry)
+            {
+                const auto position = std::find_if(entries.begin(),
+                    entries.end(),
+                    [priority = entry.priority](const Entry &existing) { return existing.priority < priority; });
+                entries.insert(position, std::move(entry));
+            }
+
+            void Flush()
+            {
+                std::erase_if(entries, [](const Entry &entry) { return !entry.alive; });
+                for (auto &entry : added)
+                {
+                    Insert(std::move(entry));
+                }
+                added.clear();
+                dirty = false;
+            }
+
+            std::vector<Entry> entries;      ///< Handlers sorted by descending priority
+            std::vector<Entry> added;        ///< Handlers subscribed during dispatch, merged afterwards
+            std::vector<TEvent> pending;     ///< Events enqueued since the last DispatchQueued()
+            std::vector<TEvent> dispatching; ///< Events being delivered by the current DispatchQueued()
+            int dispatchDepth = 0;           ///< Nesting level of Dispatch() calls in progress
+            bool dirty = false;              ///< Entries were added or removed during dispatch
+        };
+
+        template<typename TEvent> Channel<TEvent> &GetChannel()
+        {
+            return std::get<IndexOf<TEvent>>(channels);
+        }
+
+        /**
+         * @brief Checks whether every type in TTarget's parent chain is listed.
+         */
+        template<typename TTarget> static consteval bool ChainIsStatic()
+        {
+            if constexpr (std::is_void_v<TTarget>)
+            {
+                return true;
+            }
+            else
+            {
+                return Handles<TTarget> && ChainIsStatic<Detail::ParentEvent<TTarget>>();
+            }
+        }
+
+        /**
+         * @brief Checks whether any type in TTarget's parent chain is listed.
+         */
+        template<typename TTarget> static consteval bool ChainHasStatic()
+        {
+            if constexpr (std::is_void_v<TTarget>)
+            {
+                return false;
+            }
+            else
+            {
+                return Handles<TTarget> || ChainHasStatic<Detail::ParentEvent<TTarget>>();
+            }
+        }
+
+        /**
+         * @brief Dispatches one event to the listed types in TTarget's parent chain, most derived first.
+         * @return True if a handler marked the event handled
+         */
+        template<typename TTarget> bool DispatchChain(const TTarget &event)
+        {
+            if constexpr (Handles<TTarget>)
+            {
+                if (GetChannel<TTarget>().Dispatch(event))
+                {
+                    return true;
+                }
+            }
+
+            if constexpr (!std::is_void_v<Detail::ParentEvent<TTarget>>)
+            {
+                return DispatchChain<Detail::ParentEvent<TTarget>>(event);
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        template<typename TEvent> void DispatchQueue(Channel<TEvent> &channel)
+        {
+            for (const auto &event : channel.dispatching)
+            {
+                Publish(event);
+            }
+            channel.dispatching.clear();
+        }
+
+        /**
+         * @brief Removes the handler a Subscription token refers to.
+         * @param slot Index of the event type in TEvents
+         * @param generation Subscription id
+         */
+        void Unsubscribe(std::uint32_t slot, std::uint32_t generation) override
+        {
+            [this, slot, generation]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+                ((slot == Indices ? std::get<Indices>(channels).Remove(generation) : void()), ...);
+            }(std::index_sequence_for<TEvents...>{});
+        }
+
+        std::tuple<Channel<TEvents>...> channels; ///< One handler vector per event type, found at compile time
+        EventBus *fallback = nullptr;             ///< Receives events that aren't in TEvents, null when standalone
+        std::uint32_t nextId = 0;                 ///< Next subscription id; ids are never reused by Clear()
+    };
+
+    /**
+     * @brief Standalone static bus; using an event type that is not in TEvents is a compile error.
+     */
+    template<typename... TEvents> using StaticEventBus = BasicStaticEventBus<false, TEvents...>;
+
+    /**
+     * @brief Static bus layered on top of a dynamic EventBus, which receives the event types not in TEvents.
+     */
+    template<typename... TEvents> using StaticEventBusWithFallback = BasicStaticEventBus<true, TEvents...>;
+} // namespace Kappa
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Kappa
+{
+    class Subscription;
+
+    /**
+     * @brief Interface of buses that hand out Subscription tokens (EventBus, StaticEventBus).
+     */
+    class SubscriptionHost
+    {
+    public:
+        /**
+         * @brief Virtual destructor for proper cleanup of derived classes.
+         */
+        virtual ~SubscriptionHost() = default;
+
+    protected:
+        SubscriptionHost() = default;
+
+        /**
+         * @brief Creates a token that calls Unsubscribe(slot, generation) when released.
+         * @param slot Bus-defined slot
+         * @param generation Bus-defined generation
+         * @return Token owned by the subscriber
+         */
+        [[nodiscard]] Subscription MakeSubscription(std::uint32_t slot, std::uint32_t generation);
+
+        /**
+         * @brief Removes the handler a token refers to; must ignore stale tokens.
+         * @param slot Slot the token was issued with
+         * @param generation Generation the token was issued with
+         */
+        virtual void Unsubscribe(std::uint32_t slot, std::uint32_t generation) = 0;
+
+    private:
+        friend class Subscription;
+    };
+
+    /**
+     * @brief Move-only RAII token for an EventBus subscription.
+     * @note Destroying or resetting the token removes the handler. The token refers to a generational
+     *       slot, so a token that outlived EventBus::Clear() is harmless. The bus must outlive the token.
+     */
+    class Subscription
+    {
+    public:
+        /**
+         * @brief Default constructor - creates an empty token.
+         */
+        Subscription() = default;
+
+        /**
+         * @brief Destructor - removes the handler if still subscribed.
+         */
+        ~Subscription();
+
+        /**
+         * @brief Deleted copy constructor - subscriptions can't be copied.
+         */
+        Subscription(const Subscription &) = delete;
+
+        /**
+         * @brief Deleted copy assignment - subscriptions can't be copied.
+         */
+        Subscription &operator=(const Subscription &) = delete;
+
+        /**
+         * @brief Move constructor.
+         * @param other Source token (left empty)
+         */
+        Subscription(Subscription &&other) noexcept;
+
+        /**
+         * @brief Move assignment - removes the currently held handler first.
+         * @param other Source token (left empty)
+         * @return This token
+         */
+        Subscription &operator=(Subscription &&other) noexcept;
+
+        /**
+         * @brief Removes the handler now and empties the token.
+         */
+        void Reset();
+
+        /**
+         * @brief Checks if the token still refers to a subscription.
+         * @return True if not empty
+         * @note Stays true after EventBus::Clear(); the stale slot is simply ignored on removal.
+         */
+        [[nodiscard]] bool IsValid() const
+        {
+            return bus != nullptr;
+        }
+
+        explicit operator bool() const
+        {
+            return IsValid();
+        }
+
+    private:
+        friend class SubscriptionHost;
+
+        /**
+         * @brief Constructs a token for a slot in the bus subscription map.
+         * @param bus Owning bus
+         * @param slot Slot index
+         * @param generation Slot generation at subscribe time
+         */
+        Subscription(SubscriptionHost *bus, std::uint32_t slot, std::uint32_t generation);
+
+        SubscriptionHost *bus = nullptr; ///< Owning bus, null when empty
+        std::uint32_t slot = 0;          ///< Slot index in the bus subscription map
+        std::uint32_t generation = 0;    ///< Slot generation guarding against reuse
+    };
+
+    inline Subscription SubscriptionHost::MakeSubscription(std::uint32_t slot, std::uint32_t generation)
+    {
+        return Subscription(this, slot, generation);
+    }
+} // namespace Kappa
@@ -0,0 +1,503 @@
+#pragma once
+
+#include "Subscription.h"
+
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Kappa
+{
+    class Layer;
+    class TaskScheduler;
+
+    namespace Detail
+    {
+        /**
+         * @brief Allocates a coroutine frame from a per-thread pool of size classes.
+         * @param size Frame size requested by the compiler
+         * @return Frame storage; frames above the largest size class come straight from the heap
+         */
+        void *AllocateTaskFrame(std::size_t size);
+
+        /**
+         * @brief Returns a coroutine frame to the pool of the calling thread.
+         * @param frame Frame storage from AllocateTaskFrame()
+         * @param size Size that was passed to AllocateTaskFrame()
+         */
+        void FreeTaskFrame(void *frame, std::size_t size) noexcept;
+
+        /**
+         * @brief Identifies the spawned task a coroutine runs under; children inherit it from their parent.
+         */
+        struct TaskContext
+        {
+            TaskScheduler *scheduler = nullptr; ///< Scheduler resuming the task, null until spawned
+            std::uint32_t slot = 0;             ///< Slot of the spawned task
+            std::uint32_t generation = 0;       ///< Slot generation, so cancelled tasks are never resumed
+        };
+
+        /**
+         * @brief Promise state shared by every Task specialization.
+         */
+        struct TaskPromiseBase
+        {
+            /**
+             * @brief Resumes the awaiting parent, or tells the scheduler that a spawned task finished.
+             */
+            struct FinalAwaiter
+            {
+                [[nodiscard]] bool await_ready() const noexcept
+                {
+                    return false;
+                }
+
+                template<typename TPromise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<TPromise> handle) noexcept
+                {
+                    auto &promise = handle.promise();
+                    if (promise.continuation)
+                    {
+                        return promise.continuation;
+                    }
+
+                    if (promise.context.scheduler)
+                    {
+                        promise.context.scheduler->OnTaskFinished(promise.context.slot);
+                    }
+                    return std::noop_coroutine();
+                }
+
+                void await_resume() const noexcept
+                {
+                }
+            };
+
+            static void *operator new(std::size_t size)
+            {
+                return AllocateTaskFrame(size);
+            }
+
+            static void operator delete(void *frame, std::size_t size) noexcept
+            {
+                FreeTaskFrame(frame, size);
+            }
+
+            [[nodiscard]] std::suspend_always initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            [[nodiscard]] FinalAwaiter final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            void unhandled_exception() noexcept
+            {
+                exception = std::current_exception();
+            }
+
+            TaskContext context;                  ///< Spawned task this coroutine belongs to
+            std::coroutine_handle<> continuation; ///< Awaiting parent, null for spawned tasks
+            std::exception_ptr exception;         ///< Exception that escaped the coroutine body
+        };
+
+        /**
+         * @brief Promise storage for the result of a Task<T>.
+         */
+        template<typename T> struct TaskPromise : TaskPromiseBase
+        {
+            template<typename TValue>
+                requires std::is_convertible_v<TValue, T>
+            void return_value(TValue &&result)
+            {
+                value.emplace(std::forward<TValue>(result));
+            }
+
+            T TakeResult()
+            {
+                if (exception)
+                {
+                    std::rethrow_exception(exception);
+                }
+                return std::move(*value);
+            }
+
+            std::optional<T> value; ///< Result, set by co_return
+        };
+
+        template<> struct TaskPromise<void> : TaskPromiseBase
+        {
+            void return_void() const noexcept
+            {
+            }
+
+            void TakeResult() const
+            {
+                if (exception)
+                {
+                    std::rethrow_exception(exception);
+                }
+            }
+        };
+    } // namespace Detail
+
+    /**
+     * @brief Lazily started coroutine resumed by a TaskScheduler.
+     * @tparam T Result type produced by co_return
+     * @note A Task does nothing until it is awaited by another task or handed to TaskScheduler::Spawn().
+     *       Frames come from a per-thread pool of size classes, so spawning and finishing thousands of tasks
+     *       recycles memory instead of calling the global allocator. Awaiting a task resumes the caller
+     *       directly when it completes and rethrows its exception, if any.
+     *
+     * @code
+     * Task<> FadeIn(EventBus &bus)
+     * {
+     *     const auto loaded = co_await bus.Next<AssetLoadedEvent>();
+     *     co_await NextFrame();
+     *     co_await Delay(0.5f);
+     *     ...
+     * }
+     * @endcode
+     */
+    template<typename T = void> class [[nodiscard]] Task
+    {
+    public:
+        struct promise_type : Detail::TaskPromise<T>
+        {
+            Task get_return_object() noexcept
+            {
+                return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+        };
+
+        Task() = default;
+
+        /**
+         * @brief Destroys the coroutine frame if the task is still owned.
+         */
+        ~Task()
+        {
+            if (handle)
+            {
+                handle.destroy();
+            }
+        }
+
+        Task(const Task &) = delete;
+        Task &operator=(const Task &) = delete;
+
+        Task(Task &&other) noexcept : handle(std::exchange(other.handle, {}))
+        {
+        }
+
+        Task &operator=(Task &&other) noexcept
+        {
+            if (this != &other)
+            {
+                if (handle)
+                {
+                    handle.destroy();
+                }
+                handle = std::exchange(other.handle, {});
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Checks whether the task owns a coroutine.
+         * @return True unless default constructed or moved from
+         */
+        [[nodiscard]] bool IsValid() const
+        {
+            return static_cast<bool>(handle);
+        }
+
+        /**
+         * @brief Checks whether the coroutine ran to completion.
+         * @return True once the body returned or threw
+         */
+        [[nodiscard]] bool IsDone() const
+        {
+            return handle && handle.done();
+        }
+
+        /**
+         * @brief Awaiter that starts the task and resumes the awaiting coroutine when it completes.
+         */
+        struct Awaiter
+        {
+            [[nodiscard]] bool await_ready() const noexcept
+            {
+                return !child || child.done();
+            }
+
+            template<typename TPromise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<TPromise> parent) noexcept
+            {
+                child.promise().context = parent.promise().context;
+                child.promise().continuation = parent;
+                return child;
+            }
+
+            T await_resume()
+            {
+                assert(child && "Awaiting an empty task");
+                return child.promise().TakeResult();
+            }
+
+            std::coroutine_handle<promise_type> child; ///< Awaited task
+        };
+
+        /**
+         * @brief Starts the task from inside another task and suspends the caller until it completes.
+         * @return Awaiter producing the task's result
+         */
+        Awaiter operator co_await() && noexcept
+        {
+            return Awaiter{ handle };
+        }
+
+    private:
+        friend class TaskScheduler;
+
+        explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle)
+        {
+        }
+
+        std::coroutine_handle<promise_type> handle; ///< Owned coroutine frame
+    };
+
+    /**
+     * @brief Resumes spawned tasks once per frame.
+     * @note Application owns one and updates it every frame after delivering the deferred events. Each
+     *       spawned task holds a slot in a generational slot map; its Subscription token cancels the task
+     *       (destroying the whole chain of awaited frames) when reset. Spawn(), Update() and cancellation
+     *       are main-thread operations; Schedule() may be called from any thread.
+     */
+    class TaskScheduler final : public SubscriptionHost
+    {
+    public:
+        TaskScheduler() = default;
+
+        /**
+         * @brief Destroys the frames of tasks that haven't finished.
+         */
+        ~TaskScheduler() override;
+
+        TaskScheduler(const TaskScheduler &) = delete;
+        TaskScheduler &operator=(const TaskScheduler &) = delete;
+
+        /**
+         * @brief Starts a task, running it until its first suspension.
+         * @param task Task to run; the scheduler takes ownership
+         * @return Token that cancels the task when destroyed
+         * @note Exceptions escaping a spawned task are logged and end the task.
+         */
+        [[nodiscard]] Subscription Spawn(Task<> task);
+
+        /**
+         * @brief Starts a task that is cancelled when a layer is destroyed.
+         * @param owner Layer that keeps the task; the scheduler must outlive it
+         * @param task Task to run
+         */
+        void Spawn(Layer &owner, Task<> task);
+
+        /**
+         * @brief Advances the scheduler clock and resumes every task that became ready.
+         * @param timestep Seconds since the previous update
+         * @note Tasks that suspend again during the update resume in a later one, so NextFrame() and
+         *       Delay() always wait at least one update.
+         */
+        void Update(float timestep);
+
+        /**
+         * @brief Queues a suspended coroutine for the next Update().
+         * @param handle Coroutine to resume
+         * @param context Spawned task the coroutine belongs to
+         * @note Thread-safe, so event awaiters may be woken by publishers on any thread.
+         */
+        void Schedule(std::coroutine_handle<> handle, const Detail::TaskContext &context);
+
+        /**
+         * @brief Queues a suspended coroutine for the first Update() at least some seconds from now.
+         * @param seconds Delay on the scheduler clock
+         * @param handle Coroutine to resume
+         * @param context Spawned task the coroutine belongs to
+         */
+        void ScheduleAfter(double seconds, std::coroutine_handle<> handle, const Detail::TaskContext &context);
+
+        /**
+         * @brief Returns the number of spawned tasks that haven't finished.
+         * @return Live task count
+         */
+        [[nodiscard]] std::size_t GetTaskCount() const
+        {
+            return taskCount;
+        }
+
+        /**
+         * @brief Checks whether a coroutine is queued for the next Update().
+         * @return True after NextFrame() or a woken event awaiter
+         */
+        [[nodiscard]] bool HasReadyTasks();
+
+        /**
+         * @brief Returns how long until the earliest Delay() expires.
+         * @return Seconds on the scheduler clock, infinity when no task is delayed
+         */
+        [[nodiscard]] double GetTimeUntilNextTimer() const;
+
+        /**
+         * @brief Returns the scheduler clock.
+         * @return Sum of every timestep passed to Update(), in seconds
+         */
+        [[nodiscard]] double GetTime() const
+        {
+            return time;
+        }
+
+    private:
+        friend struct Detail::TaskPromiseBase::FinalAwaiter;
+
+        /**
+         * @brief A coroutine waiting to be resumed on behalf of a spawned task.
+         */
+        struct Resumption
+        {
+            std::coroutine_handle<> handle; ///< Suspended coroutine
+            std::uint32_t slot;             ///< Slot of the spawned task
+            std::uint32_t generation;       ///< Generation the task was spawned with
+        };
+
+        /**
+         * @brief Resumption waiting for the scheduler clock.
+         */
+        struct Timer
+        {
+            double wakeTime;        ///< Clock value at which the coroutine becomes ready
+            std::uint64_t sequence; ///< Tie breaker keeping equal wake times in scheduling order
+            Resumption resumption;  ///< Coroutine to resume
+
+            bool operator>(const Timer &other) const
+            {
+                return wakeTime != other.wakeTime ? wakeTime > other.wakeTime : sequence > other.sequence;
+            }
+        };
+
+        /**
+         * @brief Slot map entry of a spawned task.
+         */
+        struct TaskSlot
+        {
+            std::coroutine_handle<> handle; ///< Root frame, null when the slot is free
+            std::uint32_t generation = 0;   ///< Bumped on release so stale tokens and wakeups are ignored
+            bool running = false;           ///< The task is on the call stack
+            bool finished = false;          ///< Ran to completion or was cancelled while running
+        };
+
+        /**
+         * @brief Resumes a coroutine unless its task was cancelled, then releases the task if it ended.
+         */
+        void Resume(const Resumption &resumption);
+
+        /**
+         * @brief Marks a spawned task finished; called from its final suspension point.
+         */
+        void OnTaskFinished(std::uint32_t slot);
+
+        /**
+         * @brief Destroys a task's frames and frees its slot.
+         */
+        void Release(std::uint32_t slot);
+
+        /**
+         * @brief Cancels the task a Subscription token refers to.
+         * @note A task cancelled from inside its own body is released once it suspends.
+         */
+        void Unsubscribe(std::uint32_t slot, std::uint32_t generation) override;
+
+        std::vector<TaskSlot> tasks;          ///< Generational slot map of spawned tasks
+        std::vector<std::uint32_t> freeSlots; ///< Released slots available for reuse
+        std::vector<Resumption> ready;        ///< Coroutines to resume in the next update, guarded by readyMutex
+        std::vector<Resumption> resuming;     ///< Coroutines being resumed by the current update
+        std::vector<Timer> timers;            ///< Min-heap of delayed coroutines
+        std::mutex readyMutex;                ///< Guards ready
+        std::uint64_t timerSequence = 0;      ///< Next timer tie breaker
+        std::size_t taskCount = 0;            ///< Live spawned tasks
+        double time = 0.0;                    ///< Scheduler clock in seconds
+    };
+
+    /**
+     * @brief Awaiter suspending a task until the next TaskScheduler::Update().
+     */
+    struct NextFrameAwaiter
+    {
+        [[nodiscard]] bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        template<typename TPromise> void await_suspend(std::coroutine_handle<TPromise> handle) const
+        {
+            const auto &context = handle.promise().context;
+            assert(context.scheduler && "NextFrame() awaited outside a spawned task");
+            context.scheduler->Schedule(handle, context);
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+    /**
+     * @brief Awaiter suspending a task until the scheduler clock has advanced by some seconds.
+     */
+    struct DelayAwaiter
+    {
+        [[nodiscard]] bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        template<typename TPromise> void await_suspend(std::coroutine_handle<TPromise> handle) const
+        {
+            const auto &context = handle.promise().context;
+            assert(context.scheduler && "Delay() awaited outside a spawned task");
+            context.scheduler->ScheduleAfter(seconds, handle, context);
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+
+        double seconds; ///< Delay on the scheduler clock
+    };
+
+    /**
+     * @brief Suspends the awaiting task until the next frame.
+     * @return Awaiter for co_await
+     */
+    [[nodiscard]] inline NextFrameAwaiter NextFrame()
+    {
+        return {};
+    }
+
+    /**
+     * @brief Suspends the awaiting task for a number of seconds of frame time.
+     * @param seconds Delay; zero or negative waits one frame
+     * @return Awaiter for co_await
+     */
+    [[nodiscard]] inline DelayAwaiter Delay(double seconds)
+    {
+        return { seconds };
+    }
+} // namespace Kappa
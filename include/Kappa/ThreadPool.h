@@ -0,0 +1,310 @@
+#pragma once
+
+#include "InplaceFunction.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace Kappa
+{
+    namespace Detail
+    {
+        struct JobState;
+    } // namespace Detail
+
+    /**
+     * @brief Shared reference to a job submitted with ThreadPool::Submit(task, dependencies).
+     * @note Copyable; pass handles as dependencies of later jobs or to ThreadPool::Wait().
+     */
+    class JobHandle
+    {
+    public:
+        /**
+         * @brief Creates an empty handle, which counts as done.
+         */
+        JobHandle() = default;
+
+        /**
+         * @brief Checks whether the handle refers to a job.
+         * @return True if the handle came from Submit() or Then()
+         */
+        [[nodiscard]] bool IsValid() const
+        {
+            return state != nullptr;
+        }
+
+        /**
+         * @brief Checks whether the job has finished running.
+         * @return True once the task returned, or for an empty handle
+         */
+        [[nodiscard]] bool IsDone() const;
+
+    private:
+        friend class ThreadPool;
+
+        explicit JobHandle(std::shared_ptr<Detail::JobState> state) : state(std::move(state))
+        {
+        }
+
+        std::shared_ptr<Detail::JobState> state; ///< Job shared with the pool and its continuations
+    };
+
+    /**
+     * @brief Work-stealing job system: a fixed set of worker threads, each with its own task deque.
+     * @note Tasks submitted by a worker go to the back of its own deque and it takes its newest task first,
+     *       which keeps related work on one core. Idle workers steal the oldest task from another worker's
+     *       deque, and tasks from other threads land in a shared queue. Threads that wait on work they
+     *       handed to the pool (ParallelFor(), Wait()) run pending tasks meanwhile, so nested waits can't
+     *       deadlock. Tasks are invoked noexcept, so an exception escaping a task calls std::terminate()
+     *       wherever it runs; ParallelFor() bodies may throw (see there).
+     */
+    class ThreadPool
+    {
+    public:
+        /**
+         * @brief Task type; captures up to four pointers are stored without allocating.
+         */
+        using Task = InplaceFunction<void(), 4 * sizeof(void *)>;
+
+        /**
+         * @brief Chunks per participating thread when ParallelFor() picks the grain size.
+         */
+        static constexpr std::size_t ChunksPerThread = 8;
+
+        /**
+         * @brief Starts the workers.
+         * @param workerCount Number of worker threads; 0 runs everything on the submitting thread
+         */
+        explicit ThreadPool(std::size_t workerCount = DefaultWorkerCount());
+
+        /**
+         * @brief Finishes queued tasks and joins the workers.
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        /**
+         * @brief Returns one worker per hardware thread, leaving one for the main thread.
+         * @return Suggested worker count (at least 1)
+         */
+        [[nodiscard]] static std::size_t DefaultWorkerCount();
+
+        /**
+         * @brief Returns the number of worker threads.
+         * @return Worker count
+         */
+        [[nodiscard]] std::size_t GetWorkerCount() const
+        {
+            return workers.size();
+        }
+
+        /**
+         * @brief Queues a task for a worker.
+         * @param task Task to run
+         * @note Runs the task immediately when the pool has no workers.
+         */
+        void Submit(Task task);
+
+        /**
+         * @brief Queues a task that starts once all of its dependencies have finished.
+         * @param task Task to run
+         * @param dependencies Jobs to wait for; empty handles and finished jobs are ignored
+         * @return Handle for waiting on the job or making it a dependency
+         * @note Allocates the job's shared state. Pass `{}` for a job without dependencies.
+         */
+        [[nodiscard]] JobHandle Submit(Task task, std::span<const JobHandle> dependencies);
+
+        /**
+         * @copydoc Submit(Task, std::span<const JobHandle>)
+         */
+        [[nodiscard]] JobHandle Submit(Task task, std::initializer_list<JobHandle> dependencies)
+        {
+            return Submit(std::move(task), std::span<const JobHandle>(dependencies.begin(), dependencies.size()));
+        }
+
+        /**
+         * @brief Queues a continuation that starts once a job has finished.
+         * @param job Job to follow
+         * @param continuation Task to run afterwards
+         * @return Handle of the continuation
+         */
+        [[nodiscard]] JobHandle Then(const JobHandle &job, Task continuation)
+        {
+            return Submit(std::move(continuation), { job });
+        }
+
+        /**
+         * @brief Blocks until a job has finished, running pending tasks on the calling thread meanwhile.
+         * @param job Job to wait for
+         */
+        void Wait(const JobHandle &job);
+
+        /**
+         * @brief Runs one queued task on the calling thread, if any.
+         * @return True if a task was run
+         */
+        bool TryRunPending();
+
+        /**
+         * @brief Calls `function(i)` for every i in [0, count) across the workers and the calling thread.
+         * @tparam TFunction Callable invocable with `std::size_t`
+         * @param count Number of indices
+         * @param function Function to call; must be safe to call concurrently
+         * @note The range is split into about ChunksPerThread chunks per participating thread.
+         */
+        template<typename TFunction> void ParallelFor(std::size_t count, TFunction &&function)
+        {
+            ParallelFor(count, 0, std::forward<TFunction>(function));
+        }
+
+        /**
+         * @brief Calls `function(i)` for every i in [0, count), claiming `grainSize` indices at a time.
+         * @tparam TFunction Callable invocable with `std::size_t`
+         * @param count Number of indices
+         * @param grainSize Indices per chunk; 0 picks one from the count and the worker count
+         * @param function Function to call; must be safe to call concurrently
+         * @note Chunks are claimed one at a time, so uneven work balances itself. Returns once every
+         *       call has finished; no allocation happens for the shared state. If a call throws, no further
+         *       chunks are claimed and the first exception is rethrown once every helper has finished.
+         */
+        template<typename TFunction> void ParallelFor(std::size_t count, std::size_t grainSize, TFunction &&function)
+        {
+            if (grainSize == 0)
+            {
+                grainSize = std::max<std::size_t>(count / ((workers.size() + 1) * ChunksPerThread), 1);
+            }
+            const auto chunkCount = (count + grainSize - 1) / grainSize;
+
+            const auto helperCount = chunkCount == 0 ? 0 : std::min(workers.size(), chunkCount - 1);
+            if (helperCount == 0)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    function(i);
+                }
+                return;
+            }
+
+            std::atomic<std::size_t> nextChunk{ 0 };
+            std::atomic<std::size_t> activeHelpers{ helperCount };
+            std::mutex errorMutex;
+            std::exception_ptr error;
+            const auto drain = [&nextChunk, chunkCount, grainSize, count, &function, &errorMutex, &error] {
+                try
+                {
+                    for (auto chunk = nextChunk.fetch_add(1, std::memory_order_relaxed); chunk < chunkCount;
+                         chunk = nextChunk.fetch_add(1, std::memory_order_relaxed))
+                    {
+                        const auto end = std::min(count, (chunk + 1) * grainSize);
+                        for (auto i = chunk * grainSize; i < end; ++i)
+                        {
+                            function(i);
+                        }
+                    }
+                }
+                catch (...)
+                {
+                    // Stop the other threads claiming chunks; the caller rethrows after the join
+                    nextChunk.store(chunkCount, std::memory_order_relaxed);
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                }
+            };
+
+            for (std::size_t i = 0; i < helperCount; ++i)
+            {
+                Push([&drain, &activeHelpers] {
+                    drain();
+                    activeHelpers.fetch_sub(1, std::memory_order_release);
+                });
+            }
+
+            drain();
+
+            // Helpers reference this stack frame; wait for all of them, helping with other work meanwhile
+            while (activeHelpers.load(std::memory_order_acquire) != 0)
+            {
+                if (!TryRunPending())
+                {
+                    std::this_thread::yield();
+                }
+            }
+
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+    private:
+        /**
+         * @brief Task deque of one worker, or the shared queue for tasks from other threads.
+         */
+        struct alignas(64) TaskQueue
+        {
+            std::mutex mutex;       ///< Guards tasks
+            std::deque<Task> tasks; ///< Owner works at the back, thieves take from the front
+        };
+
+        /**
+         * @brief Queues a task on the calling worker's deque, or on the shared queue from other threads.
+         */
+        void Push(Task task);
+
+        /**
+         * @brief Takes a task from the own deque, the shared queue or another worker, in that order.
+         * @param task Receives the task
+         * @return True if a task was taken
+         */
+        bool TryTake(Task &task);
+
+        /**
+         * @brief Queues a job whose dependencies have all finished.
+         */
+        void Schedule(std::shared_ptr<Detail::JobState> job);
+
+        /**
+         * @brief Drops one pending dependency of a job, scheduling it when none remain.
+         */
+        static void ReleaseDependency(const std::shared_ptr<Detail::JobState> &job);
+
+        /**
+         * @brief Runs a job and releases its continuations.
+         */
+        static void RunJob(Detail::JobState &job);
+
+        /**
+         * @brief Runs a task; an exception escaping it terminates instead of unwinding into the pool.
+         */
+        static void Invoke(Task &task) noexcept
+        {
+            task();
+        }
+
+        void WorkerLoop(std::size_t index);
+
+        std::vector<std::thread> workers;               ///< Worker threads
+        std::vector<std::unique_ptr<TaskQueue>> queues; ///< One deque per worker
+        TaskQueue injected;                             ///< Tasks submitted from threads outside the pool
+        std::atomic<std::size_t> queuedCount{ 0 };      ///< Tasks in all queues
+        std::atomic<std::size_t> sleepingWorkers{ 0 };  ///< Workers blocked on wake
+        std::mutex sleepMutex;                          ///< Pairs with wake
+        std::condition_variable wake;                   ///< Signals workers that tasks arrived or the pool stops
+        bool stopping = false;                          ///< Set by the destructor, guarded by sleepMutex
+    };
+} // namespace Kappa
@@ -1,7 +1,11 @@
 #include "Kappa/Application.h"
+#include "Kappa/ApplicationRunner.h"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <stdexcept>
+#include <utility>
 
 #include <GLFW/glfw3.h>
 #include <glm/gtc/constants.hpp>
@@ -10,21 +14,58 @@
 
 namespace Kappa
 {
-    static Application *instance = nullptr;
+    static thread_local Application *currentApplication = nullptr;
+    static const auto processStartTime = std::chrono::steady_clock::now();
+
+    CurrentApplicationScope::CurrentApplicationScope(Application *application)
+        : previous(std::exchange(currentApplication, application))
+    {
+    }
+
+    CurrentApplicationScope::~CurrentApplicationScope()
+    {
+        currentApplication = previous;
+    }
 
     static void GLFWErrorCallback(int error, const char *description)
     {
         LOG_ERROR("[GLFW Error] ({}): {}.", error, description);
     }
 
-    Application::Application(const ApplicationSpecification &spec) : specification(spec)
+    static std::size_t ResolveWorkerCount(std::size_t requested)
+    {
+        if (requested != ApplicationSpecification::AutoWorkerCount)
+        {
+            return requested;
+        }
+
+        // Instances of a runner already fill every core, so a pool each would oversubscribe them
+        return ApplicationRunner::IsRunningInstance() ? 0 : ThreadPool::DefaultWorkerCount();
+    }
+
+    Application::Application(const ApplicationSpecification &spec)
+        : specification(spec), threadPool(ResolveWorkerCount(spec.workerThreadCount)),
+          frameLimiter(spec.targetFrameRate), creationTime(std::chrono::steady_clock::now())
     {
-        if (instance)
+        if (currentApplication)
         {
-            throw std::logic_error("Application already exists!");
+            throw std::logic_error("Application already exists on this thread!");
         }
 
-        instance = this;
+        currentApplication = this;
+
+        eventBus.SetThreadPool(&threadPool);
+
+        if (specification.fixedTimestep > 0.0f)
+        {
+            fixedTimestep.emplace(specification.fixedTimestep, std::max(specification.maxFixedStepsPerFrame, 1));
+        }
+
+        if (specification.headless)
+        {
+            LOG_INFO("Application '{}' running headless", specification.name);
+            return;
+        }
 
         glfwSetErrorCallback(GLFWErrorCallback);
         glfwInit();
@@ -40,42 +81,219 @@ namespace Kappa
 
     Application::~Application()
     {
-        window->Destroy();
+        StopSimulationThread();
 
-        glfwTerminate();
+        if (window)
+        {
+            window->Destroy();
+            glfwTerminate();
+        }
 
-        instance = nullptr;
+        if (currentApplication == this)
+        {
+            currentApplication = nullptr;
+        }
     }
 
     void Application::Run()
     {
+        // An application built on one thread may run on another
+        CurrentApplicationScope scope(this);
         isRunning = true;
 
-        // Timestep clamping: prevent simulation instability from long frames
-        constexpr float minTimestep = 0.001f; // 1ms minimum (1000 FPS cap)
-        constexpr float maxTimestep = 0.1f;   // 100ms maximum (handle long frames/debugging)
+        // Timestep clamping: prevent simulation instability from long frames (debugging, window drags).
+        // Short frames are not clamped; use targetFrameRate to limit the frame rate instead.
+        constexpr float maxTimestep = 0.1f;
+
+        // Frame times come from the monotonic clock in nanoseconds; GetTime() is a float and loses
+        // sub-millisecond precision after a few hours
+        auto lastTime = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::duration idleTime{};
+        const auto runStart = lastTime;
+        const auto runStartFrame = frameCount;
+
+        // Pace from here rather than from construction, so setup or a gap between runs isn't a missed frame
+        frameLimiter.Restart();
 
-        auto lastTime = GetTime();
+        // Stops the simulation thread however Run() exits, including by an exception from a frame
+        struct SimulationThreadGuard
+        {
+            Application &application;
+
+            ~SimulationThreadGuard()
+            {
+                application.StopSimulationThread();
+            }
+        } simulationThreadGuard{ *this };
+
+        if (specification.pipelinedRendering)
+        {
+            simulationStopping = false;
+            simulationThread = std::thread([this] { SimulationLoop(); });
+        }
 
         while (isRunning)
         {
-            glfwPollEvents();
+            bool frameDue = true;
+            if (window)
+            {
+                if (specification.reactiveRendering)
+                {
+                    frameDue = WaitForFrame(lastTime, idleTime);
+                }
+                else
+                {
+                    glfwPollEvents();
+                }
+
+                if (window->ShouldClose())
+                {
+                    Stop();
+                    break;
+                }
+            }
 
-            if (window->ShouldClose())
+            // Deliver events pushed by worker threads on the main thread. Handlers may create channels, so
+            // index over the channels that existed before draining; new ones are drained next frame.
+            const auto channelCount = eventChannels.size();
+            for (std::size_t index = 0; index < channelCount; ++index)
             {
-                Stop();
-                break;
+                frameDue = eventChannels[index]->Drain(eventBus) > 0 || frameDue;
+            }
+
+            if (!frameDue)
+            {
+                continue;
             }
 
-            const auto currentTime = GetTime();
-            const auto timestep = glm::clamp(currentTime - lastTime, minTimestep, maxTimestep);
+            // Time spent blocked while idle isn't simulated, so an animation starting after a pause doesn't jump.
+            // Tasks still see the full wall-clock time so their delays expire on schedule.
+            const auto currentTime = std::chrono::steady_clock::now();
+            auto elapsed = currentTime - lastTime;
+            auto timestep = std::min(std::chrono::duration<float>(elapsed - idleTime).count(), maxTimestep);
             lastTime = currentTime;
+            if (!window && specification.headlessTimestep > 0.0f)
+            {
+                // Batch runs simulate at a fixed rate however fast the frames actually complete
+                timestep = specification.headlessTimestep;
+                elapsed = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<float>(timestep));
+            }
+            if (idleTime > std::chrono::steady_clock::duration::zero())
+            {
+                frameLimiter.Restart();
+                idleTime = {};
+            }
 
+            if (simulationThread.joinable())
+            {
+                // Render the previous frame's snapshots while the simulation thread updates this one
+                simulationTimestep = timestep;
+                simulationFrameInFlight = true;
+                simulationStart.release();
+                RenderFrame();
+                simulationDone.acquire();
+                simulationFrameInFlight = false;
+
+                if (simulationError)
+                {
+                    std::rethrow_exception(std::exchange(simulationError, nullptr));
+                }
+            }
+            else
+            {
+                SimulateFrame(timestep);
+            }
+
+            // Deliver events deferred with EventBus::Enqueue during the update pass
+            eventBus.DispatchQueued();
+            if (staticEventBus)
+            {
+                staticEventBus->DispatchQueued();
+            }
+
+            // Resume coroutines waiting for this frame, elapsed delays or events published so far
+            taskScheduler.Update(std::chrono::duration<float>(elapsed).count());
+
+            PublishRenderSnapshots();
+
+            if (!simulationThread.joinable())
+            {
+                RenderFrame();
+            }
+
+            // Events streamed this frame become readable next frame
+            for (auto *stream : eventStreamOrder)
+            {
+                stream->Swap();
+            }
+
+            // Roll per-frame event counters (no-op unless built with ENABLE_EVENT_STATS)
+            eventBus.EndStatsFrame();
+
+            if (eventRecorder)
+            {
+                eventRecorder->EndFrame();
+            }
+
+            // Sleep-then-spin until the frame deadline when a frame-rate cap is set
+            frameLimiter.EndFrame();
+
+            frameCount++;
+            if (specification.maxFrames > 0 && frameCount - runStartFrame >= specification.maxFrames)
+            {
+                Stop();
+            }
+        }
+
+        StopSimulationThread();
+
+        if (!window)
+        {
+            const auto frames = frameCount - runStartFrame;
+            const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+            LOG_INFO("Headless run finished: {} frames in {:.3f} s ({:.1f} FPS)", frames, seconds,
+                seconds > 0.0 ? static_cast<double>(frames) / seconds : 0.0);
+        }
+    }
+
+    void Application::SimulateFrame(float timestep)
+    {
+        if (fixedTimestep)
+        {
+            const auto steps = fixedTimestep->Advance(timestep);
+            for (int step = 0; step < steps; ++step)
+            {
+                for (auto &layer : layerStack)
+                {
+                    layer->OnFixedUpdate(fixedTimestep->GetStepSize());
+                }
+            }
+        }
+
+        if (layerGraphDirty)
+        {
+            layerUpdateGraph.Build(layerStack);
+            layerGraphDirty = false;
+        }
+
+        if (specification.parallelLayerUpdates)
+        {
+            layerUpdateGraph.Update(timestep, threadPool, this);
+        }
+        else
+        {
             for (auto &layer : layerStack)
             {
                 layer->OnUpdate(timestep);
             }
+        }
+    }
 
+    void Application::RenderFrame()
+    {
+        if (window || specification.headlessRender)
+        {
             BeginFrame();
 
             for (auto &layer : layerStack)
@@ -84,11 +302,123 @@ namespace Kappa
             }
 
             EndFrame();
+        }
 
+        if (window)
+        {
             window->Update();
         }
     }
 
+    void Application::PublishRenderSnapshots()
+    {
+        for (auto &layer : layerStack)
+        {
+            for (auto *snapshot : layer->renderSnapshots)
+            {
+                snapshot->Publish();
+            }
+        }
+        renderInterpolationAlpha = fixedTimestep ? fixedTimestep->GetAlpha() : 1.0f;
+    }
+
+    void Application::SimulationLoop()
+    {
+        CurrentApplicationScope scope(this);
+
+        for (;;)
+        {
+            simulationStart.acquire();
+            if (simulationStopping)
+            {
+                return;
+            }
+
+            try
+            {
+                SimulateFrame(simulationTimestep);
+            }
+            catch (...)
+            {
+                simulationError = std::current_exception();
+            }
+            simulationDone.release();
+        }
+    }
+
+    void Application::StopSimulationThread()
+    {
+        if (!simulationThread.joinable())
+        {
+            return;
+        }
+
+        // When rendering threw, the frame handed over may still be running, or its start permit may still be
+        // pending. Wait for it first: a second release of the binary semaphore would be undefined, and the
+        // frame must not outlive the members it uses. Its exception is dropped for the one in flight.
+        if (simulationFrameInFlight)
+        {
+            simulationDone.acquire();
+            simulationFrameInFlight = false;
+            simulationError = nullptr;
+        }
+
+        simulationStopping = true;
+        simulationStart.release();
+        simulationThread.join();
+    }
+
+    bool Application::IsFrameRequested(double sinceLastFrame)
+    {
+        // Consume the request first so it isn't left pending when another condition already holds
+        const bool requested = frameRequested.exchange(false, std::memory_order_acq_rel);
+        return requested || std::chrono::steady_clock::now() < continuousUntil || taskScheduler.HasReadyTasks() ||
+               taskScheduler.GetTimeUntilNextTimer() <= sinceLastFrame;
+    }
+
+    bool Application::WaitForFrame(
+        std::chrono::steady_clock::time_point lastFrameTime, std::chrono::steady_clock::duration &idleTime)
+    {
+        using Seconds = std::chrono::duration<double>;
+
+        const auto waitStart = std::chrono::steady_clock::now();
+        const auto sinceLastFrame = Seconds(waitStart - lastFrameTime).count();
+        if (IsFrameRequested(sinceLastFrame))
+        {
+            glfwPollEvents();
+            return true;
+        }
+
+        const auto untilTimer = taskScheduler.GetTimeUntilNextTimer() - sinceLastFrame;
+        const auto timeout = std::max(std::min(static_cast<double>(specification.idleTimeout), untilTimer), 0.0);
+        glfwWaitEventsTimeout(timeout);
+
+        const auto waitEnd = std::chrono::steady_clock::now();
+        idleTime += waitEnd - waitStart;
+
+        // Returning well before the timeout means input, a window refresh or RequestFrame() woke the loop
+        constexpr double wakeTolerance = 0.001;
+        const bool woken = Seconds(waitEnd - waitStart).count() + wakeTolerance < timeout;
+        return IsFrameRequested(Seconds(waitEnd - lastFrameTime).count()) || woken;
+    }
+
+    void Application::RequestFrame()
+    {
+        frameRequested.store(true, std::memory_order_release);
+        if (specification.reactiveRendering && window)
+        {
+            glfwPostEmptyEvent();
+        }
+    }
+
+    void Application::RequestFrames(float seconds)
+    {
+        const auto until = std::chrono::steady_clock::now() +
+                           std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                               std::chrono::duration<float>(seconds));
+        continuousUntil = std::max(continuousUntil, until);
+    }
+
     void Application::Stop()
     {
         isRunning = false;
@@ -96,6 +426,11 @@ namespace Kappa
 
     glm::vec2 Application::GetFramebufferSize() const
     {
+        if (!window)
+        {
+            return { static_cast<float>(specification.windowSpecification.width),
+                static_cast<float>(specification.windowSpecification.height) };
+        }
         return window->GetFrameBufferSize();
     }
 
@@ -118,17 +453,64 @@ namespace Kappa
 
     Application &Application::Get()
     {
-        assert(instance);
-        return *instance;
+        assert(currentApplication);
+        return *currentApplication;
+    }
+
+    Application *Application::TryGet()
+    {
+        return currentApplication;
     }
 
     float Application::GetTime()
     {
-        return static_cast<float>(glfwGetTime());
+        const auto origin = currentApplication ? currentApplication->creationTime : processStartTime;
+        return std::chrono::duration<float>(std::chrono::steady_clock::now() - origin).count();
     }
 
     EventBus &Application::GetEventBus()
     {
         return eventBus;
     }
+
+    void Application::SetEventRecorder(EventRecorder *recorder)
+    {
+        eventRecorder = recorder;
+    }
+
+    ThreadPool &Application::GetThreadPool()
+    {
+        return threadPool;
+    }
+
+    float Application::GetInterpolationAlpha() const
+    {
+        if (!fixedTimestep)
+        {
+            return 1.0f;
+        }
+        // The simulation thread advances the accumulator while the main thread renders
+        return specification.pipelinedRendering ? renderInterpolationAlpha : fixedTimestep->GetAlpha();
+    }
+
+    const FixedTimestep *Application::GetFixedTimestep() const
+    {
+        return fixedTimestep ? &*fixedTimestep : nullptr;
+    }
+
+    void Application::SetTargetFrameRate(float targetFrameRate)
+    {
+        specification.targetFrameRate = targetFrameRate;
+        frameLimiter.SetTargetFrameRate(targetFrameRate);
+    }
+
+    FramePacingStats Application::GetFramePacingStats() const
+    {
+        return frameLimiter.GetStats();
+    }
+
+    TaskScheduler &Application::GetTaskScheduler()
+    {
+        return taskScheduler;
+    }
 } // namespace Kappa
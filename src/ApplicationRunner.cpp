@@ -0,0 +1,89 @@
+#include "Kappa/ApplicationRunner.h"
+#include "Kappa/Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <latch>
+#include <stdexcept>
+
+namespace Kappa
+{
+    namespace
+    {
+        thread_local bool runningInstance = false; ///< Calling thread is inside RunInstance()
+
+        /**
+         * @brief State shared by the instances of one ApplicationRunner::Run() call.
+         */
+        struct RunContext
+        {
+            const ApplicationRunner::Factory &factory;  ///< Creates each instance
+            std::vector<ApplicationRunResult> &results; ///< One slot per instance, written by its worker only
+            std::latch &finished;                       ///< Counts down once per instance
+        };
+
+        void RunInstance(RunContext &context, std::size_t index)
+        {
+            auto &result = context.results[index];
+            result.index = index;
+            runningInstance = true;
+
+            try
+            {
+                auto application = context.factory(index);
+                if (!application || !application->IsHeadless())
+                {
+                    throw std::logic_error("ApplicationRunner requires a headless application");
+                }
+
+                const auto start = std::chrono::steady_clock::now();
+                application->Run();
+                result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                result.frameCount = application->GetFrameCount();
+                result.pacing = application->GetFramePacingStats();
+                result.succeeded = true;
+            }
+            catch (const std::exception &error)
+            {
+                result.error = error.what();
+            }
+            catch (...)
+            {
+                result.error = "Unknown exception";
+            }
+
+            runningInstance = false;
+            if (!result.succeeded)
+            {
+                LOG_ERROR("ApplicationRunner: Instance {} failed: {}", index, result.error);
+            }
+            context.finished.count_down();
+        }
+    } // namespace
+
+    ApplicationRunner::ApplicationRunner(std::size_t threadCount) : pool(std::max<std::size_t>(threadCount, 1))
+    {
+    }
+
+    bool ApplicationRunner::IsRunningInstance()
+    {
+        return runningInstance;
+    }
+
+    std::vector<ApplicationRunResult> ApplicationRunner::Run(std::size_t instanceCount, const Factory &factory)
+    {
+        std::vector<ApplicationRunResult> results(instanceCount);
+        std::latch finished(static_cast<std::ptrdiff_t>(instanceCount));
+        RunContext context{ factory, results, finished };
+
+        // Instances run on the workers only, so the caller's own current application never collides with them
+        for (std::size_t index = 0; index < instanceCount; ++index)
+        {
+            pool.Submit([&context, index] { RunInstance(context, index); });
+        }
+
+        finished.wait();
+        return results;
+    }
+} // namespace Kappa
@@ -0,0 +1,283 @@
+#include "Kappa/EventRecording.h"
+#include "Kappa/Logger.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace Kappa
+{
+    EventRecorder::~EventRecorder()
+    {
+        // Drop the observers first so no publisher can reach a recorder being destroyed
+        subscriptions.clear();
+        Close();
+    }
+
+    bool EventRecorder::Open(const std::string &filePath)
+    {
+        Close();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        file.open(filePath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            LOG_ERROR("EventRecorder: Failed to open '{}' for writing", filePath);
+            return false;
+        }
+
+        frameIndex = 0;
+        lastEventFrame = 0;
+        eventCount = 0;
+
+        records.Clear();
+        records.WriteBytes(Detail::RecordingMagic, sizeof(Detail::RecordingMagic));
+        records.Write(Detail::RecordingVersion);
+        for (std::uint32_t typeId = 0; typeId < typeNames.size(); ++typeId)
+        {
+            WriteTypeRecord(typeId);
+        }
+        Flush();
+
+        LOG_INFO("EventRecorder: Recording events to '{}'", filePath);
+        return true;
+    }
+
+    void EventRecorder::Close()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!file.is_open())
+        {
+            return;
+        }
+
+        records.Write(Detail::RecordTag::End);
+        records.WriteVarint(frameIndex);
+        Flush();
+        file.close();
+    }
+
+    void EventRecorder::EndFrame()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!file.is_open())
+        {
+            return;
+        }
+
+        frameIndex++;
+        Flush();
+    }
+
+    std::uint64_t EventRecorder::GetFrameIndex() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return frameIndex;
+    }
+
+    std::uint64_t EventRecorder::GetEventCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return eventCount;
+    }
+
+    std::uint32_t EventRecorder::DeclareType(std::string_view name)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto typeId = static_cast<std::uint32_t>(typeNames.size());
+        typeNames.emplace_back(name);
+        if (file.is_open())
+        {
+            WriteTypeRecord(typeId);
+        }
+        return typeId;
+    }
+
+    void EventRecorder::WriteTypeRecord(std::uint32_t typeId)
+    {
+        records.Write(Detail::RecordTag::Type);
+        records.WriteVarint(typeId);
+        records.WriteString(typeNames[typeId]);
+    }
+
+    void EventRecorder::AppendEvent(std::uint32_t typeId, std::optional<std::uint64_t> key)
+    {
+        const auto bytes = payload.GetData();
+        records.Write(key ? Detail::RecordTag::KeyedEvent : Detail::RecordTag::Event);
+        records.WriteVarint(frameIndex - lastEventFrame);
+        records.WriteVarint(typeId);
+        if (key)
+        {
+            records.WriteVarint(*key);
+        }
+        records.WriteVarint(bytes.size());
+        records.WriteBytes(bytes.data(), bytes.size());
+
+        lastEventFrame = frameIndex;
+        eventCount++;
+    }
+
+    void EventRecorder::Flush()
+    {
+        const auto bytes = records.GetData();
+        file.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        file.flush();
+        records.Clear();
+    }
+
+    bool EventReplayer::Open(const std::string &filePath)
+    {
+        data.clear();
+        typeNames.clear();
+        events.clear();
+        frameCount = 0;
+        Rewind();
+
+        std::ifstream file(filePath, std::ios::binary);
+        if (!file.is_open())
+        {
+            LOG_ERROR("EventReplayer: Failed to open '{}'", filePath);
+            return false;
+        }
+
+        std::transform(std::istreambuf_iterator<char>(file),
+            std::istreambuf_iterator<char>(),
+            std::back_inserter(data),
+            [](char byte) { return static_cast<std::byte>(byte); });
+
+        BinaryReader reader(data);
+        char magic[sizeof(Detail::RecordingMagic)] = {};
+        reader.ReadBytes(magic, sizeof(magic));
+        const auto version = reader.Read<std::uint32_t>();
+        if (!reader.IsValid() || !std::equal(std::begin(magic), std::end(magic), Detail::RecordingMagic) ||
+            version == 0 || version > Detail::RecordingVersion)
+        {
+            LOG_ERROR(
+                "EventReplayer: '{}' is not an event recording of version 1 to {}", filePath, Detail::RecordingVersion);
+            data.clear();
+            return false;
+        }
+
+        // Index every record up front; a record cut short by a crash ends the recording
+        std::uint64_t frame = 0;
+        bool ended = false;
+        bool complete = false;
+        while (reader.GetRemaining() > 0 && !ended)
+        {
+            const auto tag = reader.Read<Detail::RecordTag>();
+            switch (tag)
+            {
+            case Detail::RecordTag::Type:
+            {
+                const auto typeId = reader.ReadVarint();
+                auto name = reader.ReadString();
+                if (reader.IsValid() && typeId < std::numeric_limits<std::uint32_t>::max())
+                {
+                    typeNames.resize(std::max<std::size_t>(typeNames.size(), typeId + 1));
+                    typeNames[typeId] = std::move(name);
+                }
+                break;
+            }
+            case Detail::RecordTag::Event:
+            case Detail::RecordTag::KeyedEvent:
+            {
+                frame += reader.ReadVarint();
+                const auto typeId = reader.ReadVarint();
+                std::optional<std::uint64_t> key;
+                if (tag == Detail::RecordTag::KeyedEvent)
+                {
+                    key = reader.ReadVarint();
+                }
+                const auto size = reader.ReadVarint();
+                if (!reader.IsValid() || size > reader.GetRemaining() || typeId >= typeNames.size())
+                {
+                    ended = true;
+                    break;
+                }
+
+                const auto offset = data.size() - reader.GetRemaining();
+                events.push_back(
+                    { frame, static_cast<std::uint32_t>(typeId), offset, static_cast<std::size_t>(size), key });
+                reader.Skip(static_cast<std::size_t>(size));
+                break;
+            }
+            case Detail::RecordTag::End:
+                frameCount = reader.ReadVarint();
+                complete = reader.IsValid();
+                ended = true;
+                break;
+            default:
+                ended = true;
+                break;
+            }
+        }
+
+        if (!complete)
+        {
+            LOG_WARN("EventReplayer: '{}' has no end record, replaying up to the last event", filePath);
+        }
+        if (!events.empty())
+        {
+            frameCount = std::max(frameCount, events.back().frame + 1);
+        }
+
+        ResolvePublishers();
+        LOG_INFO("EventReplayer: Loaded {} events over {} frames from '{}'", events.size(), frameCount, filePath);
+        return true;
+    }
+
+    bool EventReplayer::PublishFrame(EventBus &bus)
+    {
+        if (frameIndex >= frameCount)
+        {
+            return false;
+        }
+
+        const std::span<const std::byte> bytes(data);
+        for (; nextEvent < events.size() && events[nextEvent].frame == frameIndex; ++nextEvent)
+        {
+            const auto &event = events[nextEvent];
+            if (const auto publisher = resolved[event.typeId])
+            {
+                BinaryReader reader(bytes.subspan(event.offset, event.size));
+                publisher(reader, bus, event.key);
+            }
+        }
+
+        frameIndex++;
+        return true;
+    }
+
+    std::uint64_t EventReplayer::Run(EventBus &bus, std::span<const std::unique_ptr<Layer>> layers, float timestep)
+    {
+        std::uint64_t frames = 0;
+        while (PublishFrame(bus))
+        {
+            for (const auto &layer : layers)
+            {
+                layer->OnUpdate(timestep);
+            }
+            bus.DispatchQueued();
+            frames++;
+        }
+        return frames;
+    }
+
+    void EventReplayer::Rewind()
+    {
+        frameIndex = 0;
+        nextEvent = 0;
+    }
+
+    void EventReplayer::ResolvePublishers()
+    {
+        resolved.assign(typeNames.size(), nullptr);
+        for (std::size_t typeId = 0; typeId < typeNames.size(); ++typeId)
+        {
+            if (const auto it = publishers.find(typeNames[typeId]); it != publishers.end())
+            {
+                resolved[typeId] = it->second;
+            }
+        }
+    }
+} // namespace Kappa
@@ -0,0 +1,58 @@
+#include "Kappa/EventStats.h"
+
+#include <nlohmann/json.hpp>
+
+namespace Kappa
+{
+    std::string EventBusStats::ToJson(int indent) const
+    {
+        nlohmann::json json;
+        json["frameCount"] = frameCount;
+        json["eventTypes"] = nlohmann::json::array();
+
+        for (const auto &eventType : eventTypes)
+        {
+            nlohmann::json type;
+            type["name"] = eventType.name;
+            type["publishCount"] = eventType.publishCount;
+            type["publishesLastFrame"] = eventType.publishesLastFrame;
+            type["maxPublishesPerFrame"] = eventType.maxPublishesPerFrame;
+            type["subscriberCount"] = eventType.subscriberCount;
+            type["totalHandlerNanoseconds"] = eventType.totalHandlerNanoseconds;
+            type["maxHandlerNanoseconds"] = eventType.maxHandlerNanoseconds;
+            type["handlers"] = nlohmann::json::array();
+
+            for (const auto &handler : eventType.handlers)
+            {
+                nlohmann::json entry;
+                entry["name"] = handler.name;
+                entry["priority"] = handler.priority;
+                entry["callCount"] = handler.callCount;
+                entry["totalNanoseconds"] = handler.totalNanoseconds;
+                entry["maxNanoseconds"] = handler.maxNanoseconds;
+                entry["p50Nanoseconds"] = handler.latency.GetValueAtPercentile(50.0);
+                entry["p90Nanoseconds"] = handler.latency.GetValueAtPercentile(90.0);
+                entry["p99Nanoseconds"] = handler.latency.GetValueAtPercentile(99.0);
+                entry["p999Nanoseconds"] = handler.latency.GetValueAtPercentile(99.9);
+
+                // Sparse [upperBoundNanoseconds, count] pairs keep the dump small
+                auto histogram = nlohmann::json::array();
+                const auto &buckets = handler.latency.GetBuckets();
+                for (std::size_t i = 0; i < buckets.size(); ++i)
+                {
+                    if (buckets[i] != 0)
+                    {
+                        histogram.push_back({ LatencyHistogram::BucketUpperBound(i), buckets[i] });
+                    }
+                }
+                entry["histogram"] = std::move(histogram);
+
+                type["handlers"].push_back(std::move(entry));
+            }
+
+            json["eventTypes"].push_back(std::move(type));
+        }
+
+        return json.dump(indent);
+    }
+} // namespace Kappa
@@ -0,0 +1,118 @@
+#include "Kappa/FrameLimiter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+namespace Kappa
+{
+    namespace
+    {
+        constexpr auto InitialSpinMargin = std::chrono::microseconds(1500);
+        constexpr auto MinSpinMargin = std::chrono::microseconds(200);
+        constexpr auto MaxSpinMargin = std::chrono::milliseconds(4);
+    } // namespace
+
+    FrameLimiter::FrameLimiter(double framesPerSecond)
+        : spinMargin(InitialSpinMargin), deadline(Clock::now()), lastFrameEnd(deadline)
+    {
+        SetTargetFrameRate(framesPerSecond);
+    }
+
+    void FrameLimiter::SetTargetFrameRate(double framesPerSecond)
+    {
+        targetFrameRate = framesPerSecond > 0.0 ? framesPerSecond : 0.0;
+        period = targetFrameRate > 0.0
+                     ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetFrameRate))
+                     : Clock::duration::zero();
+        deadline = lastFrameEnd + period;
+    }
+
+    void FrameLimiter::EndFrame()
+    {
+        if (period > Clock::duration::zero())
+        {
+            if (Clock::now() > deadline)
+            {
+                // Late: start a fresh schedule rather than squeezing the following frames
+                missedFrames++;
+                deadline = Clock::now();
+            }
+            else
+            {
+                WaitUntil(deadline);
+            }
+            deadline += period;
+        }
+
+        const auto now = Clock::now();
+        const auto frameTime = std::chrono::duration_cast<std::chrono::nanoseconds>(now - lastFrameEnd).count();
+        lastFrameEnd = now;
+
+        frames[nextSample] = static_cast<std::uint64_t>(frameTime);
+        nextSample = (nextSample + 1) % WindowSize;
+        frameCount++;
+    }
+
+    void FrameLimiter::Restart()
+    {
+        lastFrameEnd = Clock::now();
+        deadline = lastFrameEnd + period;
+    }
+
+    FramePacingStats FrameLimiter::GetStats() const
+    {
+        FramePacingStats stats;
+        stats.targetFrameNanoseconds =
+            static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(period).count());
+        stats.frameCount = frameCount;
+        stats.missedFrames = missedFrames;
+        stats.sampleCount = static_cast<std::size_t>(std::min<std::uint64_t>(frameCount, WindowSize));
+        if (stats.sampleCount == 0)
+        {
+            return stats;
+        }
+
+        double sum = 0.0;
+        stats.minFrameNanoseconds = std::numeric_limits<std::uint64_t>::max();
+        for (std::size_t i = 0; i < stats.sampleCount; ++i)
+        {
+            sum += static_cast<double>(frames[i]);
+            stats.minFrameNanoseconds = std::min(stats.minFrameNanoseconds, frames[i]);
+            stats.maxFrameNanoseconds = std::max(stats.maxFrameNanoseconds, frames[i]);
+        }
+        stats.averageFrameNanoseconds = sum / static_cast<double>(stats.sampleCount);
+
+        double squares = 0.0;
+        for (std::size_t i = 0; i < stats.sampleCount; ++i)
+        {
+            const auto deviation = static_cast<double>(frames[i]) - stats.averageFrameNanoseconds;
+            squares += deviation * deviation;
+        }
+        stats.jitterNanoseconds = std::sqrt(squares / static_cast<double>(stats.sampleCount));
+
+        return stats;
+    }
+
+    void FrameLimiter::WaitUntil(Clock::time_point wakeTime)
+    {
+        const auto remaining = wakeTime - Clock::now();
+        if (remaining > spinMargin)
+        {
+            const auto requested = remaining - spinMargin;
+            const auto sleepStart = Clock::now();
+            std::this_thread::sleep_for(requested);
+            const auto overshoot = (Clock::now() - sleepStart) - requested;
+
+            // Widen the margin at once after an oversleep, narrow it slowly while sleeps stay accurate
+            const auto target = std::clamp<Clock::duration>(overshoot * 2, MinSpinMargin, MaxSpinMargin);
+            spinMargin = target > spinMargin ? target : spinMargin - (spinMargin - target) / 16;
+        }
+
+        while (Clock::now() < wakeTime)
+        {
+            std::this_thread::yield();
+        }
+    }
+} // namespace Kappa
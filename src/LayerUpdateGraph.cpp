@@ -0,0 +1,181 @@
+#include "Kappa/LayerUpdateGraph.h"
+#include "Kappa/Application.h"
+
+#include <algorithm>
+#include <exception>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace Kappa
+{
+    namespace
+    {
+        bool Conflicts(const Layer &earlier, const Layer &later)
+        {
+            if (!earlier.HasDeclaredAccess() || !later.HasDeclaredAccess())
+            {
+                return true;
+            }
+
+            for (const auto &first : earlier.GetResourceAccesses())
+            {
+                for (const auto &second : later.GetResourceAccesses())
+                {
+                    if (first.resource == second.resource && (first.write || second.write))
+                    {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+    } // namespace
+
+    void LayerUpdateGraph::Build(std::span<const std::unique_ptr<Layer>> layers)
+    {
+        nodes.clear();
+        nodes.resize(layers.size());
+        mainThreadReady.clear();
+        mainThreadReady.reserve(layers.size());
+        pending = std::make_unique<std::atomic<std::uint32_t>[]>(layers.size());
+        hasWorkerLayers = false;
+
+        // Chain length ending at each layer, for the critical path
+        std::vector<std::size_t> chainLength(layers.size(), 1);
+        criticalPathLength = 0;
+
+        for (std::uint32_t later = 0; later < layers.size(); ++later)
+        {
+            nodes[later].layer = layers[later].get();
+            nodes[later].mainThread = !layers[later]->HasDeclaredAccess();
+            hasWorkerLayers = hasWorkerLayers || !nodes[later].mainThread;
+
+            for (std::uint32_t earlier = 0; earlier < later; ++earlier)
+            {
+                if (Conflicts(*layers[earlier], *layers[later]))
+                {
+                    nodes[earlier].successors.push_back(later);
+                    nodes[later].dependencyCount++;
+                    chainLength[later] = std::max(chainLength[later], chainLength[earlier] + 1);
+                }
+            }
+            criticalPathLength = std::max(criticalPathLength, chainLength[later]);
+        }
+    }
+
+    void LayerUpdateGraph::Update(float timestep, ThreadPool &pool, Application *application)
+    {
+        if (!hasWorkerLayers || pool.GetWorkerCount() == 0)
+        {
+            for (const auto &node : nodes)
+            {
+                node.layer->OnUpdate(timestep);
+            }
+            return;
+        }
+
+        frameTimestep = timestep;
+        framePool = &pool;
+        frameApplication = application;
+        for (std::uint32_t index = 0; index < nodes.size(); ++index)
+        {
+            pending[index].store(nodes[index].dependencyCount, std::memory_order_relaxed);
+        }
+        remaining.store(nodes.size(), std::memory_order_relaxed);
+        frameFailed.store(false, std::memory_order_relaxed);
+
+        for (std::uint32_t index = 0; index < nodes.size(); ++index)
+        {
+            if (nodes[index].dependencyCount == 0)
+            {
+                MakeReady(index);
+            }
+        }
+
+        while (remaining.load(std::memory_order_acquire) != 0)
+        {
+            std::uint32_t index = 0;
+            bool haveMainThreadLayer = false;
+            {
+                std::lock_guard<std::mutex> lock(mainThreadMutex);
+                if (!mainThreadReady.empty())
+                {
+                    index = mainThreadReady.back();
+                    mainThreadReady.pop_back();
+                    haveMainThreadLayer = true;
+                }
+            }
+
+            if (haveMainThreadLayer)
+            {
+                RunNode(index);
+            }
+            else if (!pool.TryRunPending())
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        if (frameFailed.load(std::memory_order_relaxed))
+        {
+            std::rethrow_exception(std::exchange(frameError, nullptr));
+        }
+    }
+
+    bool LayerUpdateGraph::DependsOn(std::size_t later, std::size_t earlier) const
+    {
+        const auto &successors = nodes[earlier].successors;
+        return std::find(successors.begin(), successors.end(), later) != successors.end();
+    }
+
+    void LayerUpdateGraph::RunNode(std::uint32_t index)
+    {
+        // Once a layer has thrown, the layers not yet started are skipped like the rest of a sequential stack
+        if (!frameFailed.load(std::memory_order_acquire))
+        {
+            try
+            {
+                // Layers reach their application through Application::Get() whichever thread they run on
+                std::optional<CurrentApplicationScope> scope;
+                if (frameApplication)
+                {
+                    scope.emplace(frameApplication);
+                }
+                nodes[index].layer->OnUpdate(frameTimestep);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mainThreadMutex);
+                if (!frameFailed.load(std::memory_order_relaxed))
+                {
+                    frameError = std::current_exception();
+                    frameFailed.store(true, std::memory_order_release);
+                }
+            }
+        }
+
+        for (const auto successor : nodes[index].successors)
+        {
+            if (pending[successor].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                MakeReady(successor);
+            }
+        }
+
+        // Last access to this graph from a worker; Update() may return right after
+        remaining.fetch_sub(1, std::memory_order_release);
+    }
+
+    void LayerUpdateGraph::MakeReady(std::uint32_t index)
+    {
+        if (nodes[index].mainThread)
+        {
+            std::lock_guard<std::mutex> lock(mainThreadMutex);
+            mainThreadReady.push_back(index);
+            return;
+        }
+
+        framePool->Submit([this, index] { RunNode(index); });
+    }
+} // namespace Kappa
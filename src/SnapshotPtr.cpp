@@ -0,0 +1,77 @@
+#include "Kappa/SnapshotPtr.h"
+
+namespace Kappa::Detail
+{
+    namespace
+    {
+        std::atomic<EpochRecord *> epochRecords{ nullptr }; ///< Every record ever registered
+
+        /**
+         * @brief Returns the calling thread's record to the pool when the thread exits.
+         */
+        struct EpochRecordRelease
+        {
+            ~EpochRecordRelease()
+            {
+                if (epochRecord)
+                {
+                    epochRecord->inUse.store(false, std::memory_order_release);
+                    epochRecord = nullptr;
+                }
+            }
+        };
+
+        thread_local EpochRecordRelease epochRecordRelease; ///< Releases epochRecord at thread exit
+    } // namespace
+
+    EpochRecord *AcquireEpochRecord()
+    {
+        // Touching the releaser registers its destructor for this thread
+        static_cast<void>(epochRecordRelease);
+
+        for (auto *record = epochRecords.load(std::memory_order_seq_cst); record; record = record->next)
+        {
+            bool expected = false;
+            if (!record->inUse.load(std::memory_order_relaxed) &&
+                record->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            {
+                epochRecord = record;
+                return record;
+            }
+        }
+
+        // Records are reachable from epochRecords for the life of the process and never freed
+        auto *record = new EpochRecord();
+        record->inUse.store(true, std::memory_order_relaxed);
+        record->next = epochRecords.load(std::memory_order_relaxed);
+        while (!epochRecords.compare_exchange_weak(
+            record->next, record, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+        }
+
+        epochRecord = record;
+        return record;
+    }
+
+    std::uint64_t TryAdvanceEpoch()
+    {
+        auto epoch = globalEpoch.load(std::memory_order_seq_cst);
+        // A record registered after this load belongs to a thread that pins after it, so it can't hold
+        // a snapshot unlinked before it
+        for (auto *record = epochRecords.load(std::memory_order_seq_cst); record; record = record->next)
+        {
+            // Reading the unpinning release store makes the reader's snapshot accesses happen before any free
+            const auto pinned = record->pinned.load(std::memory_order_seq_cst);
+            if (pinned != 0 && pinned != epoch)
+            {
+                return epoch;
+            }
+        }
+
+        if (globalEpoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst))
+        {
+            return epoch + 1;
+        }
+        return epoch;
+    }
+} // namespace Kappa::Detail
@@ -0,0 +1,41 @@
+#include "Kappa/Subscription.h"
+
+#include <utility>
+
+namespace Kappa
+{
+    Subscription::Subscription(SubscriptionHost *bus, std::uint32_t slot, std::uint32_t generation)
+        : bus(bus), slot(slot), generation(generation)
+    {
+    }
+
+    Subscription::~Subscription()
+    {
+        Reset();
+    }
+
+    Subscription::Subscription(Subscription &&other) noexcept
+        : bus(std::exchange(other.bus, nullptr)), slot(other.slot), generation(other.generation)
+    {
+    }
+
+    Subscription &Subscription::operator=(Subscription &&other) noexcept
+    {
+        if (this != &other)
+        {
+            Reset();
+            bus = std::exchange(other.bus, nullptr);
+            slot = other.slot;
+            generation = other.generation;
+        }
+        return *this;
+    }
+
+    void Subscription::Reset()
+    {
+        if (bus)
+        {
+            std::exchange(bus, nullptr)->Unsubscribe(slot, generation);
+        }
+    }
+} // namespace Kappa
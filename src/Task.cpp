@@ -0,0 +1,262 @@
+#include "Kappa/Task.h"
+#include "Kappa/Layer.h"
+#include "Kappa/Logger.h"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <limits>
+#include <new>
+
+namespace Kappa
+{
+    namespace
+    {
+        /**
+         * @brief Per-thread free lists of coroutine frames, one per 64-byte size class.
+         * @note Blocks are individual heap allocations, so a frame freed on another thread than the one that
+         *       allocated it simply joins that thread's list. Cached blocks are released when the thread exits.
+         */
+        class TaskFramePool
+        {
+        public:
+            static constexpr std::size_t Granularity = 64; ///< Size class width in bytes
+            static constexpr std::size_t ClassCount = 16;  ///< Frames above 1 KiB bypass the pool
+
+            TaskFramePool() = default;
+            TaskFramePool(const TaskFramePool &) = delete;
+            TaskFramePool &operator=(const TaskFramePool &) = delete;
+
+            ~TaskFramePool()
+            {
+                for (auto *block : freeLists)
+                {
+                    while (block)
+                    {
+                        ::operator delete(std::exchange(block, block->next));
+                    }
+                }
+            }
+
+            void *Allocate(std::size_t size)
+            {
+                const auto sizeClass = ClassOf(size);
+                if (sizeClass >= ClassCount)
+                {
+                    return ::operator new(size);
+                }
+
+                if (auto *block = freeLists[sizeClass])
+                {
+                    freeLists[sizeClass] = block->next;
+                    return block;
+                }
+                return ::operator new((sizeClass + 1) * Granularity);
+            }
+
+            void Free(void *frame, std::size_t size) noexcept
+            {
+                const auto sizeClass = ClassOf(size);
+                if (sizeClass >= ClassCount)
+                {
+                    ::operator delete(frame);
+                    return;
+                }
+
+                auto *block = static_cast<FreeBlock *>(frame);
+                block->next = freeLists[sizeClass];
+                freeLists[sizeClass] = block;
+            }
+
+        private:
+            struct FreeBlock
+            {
+                FreeBlock *next; ///< Next cached block of the same size class
+            };
+
+            static std::size_t ClassOf(std::size_t size)
+            {
+                return (std::max(size, sizeof(FreeBlock)) - 1) / Granularity;
+            }
+
+            std::array<FreeBlock *, ClassCount> freeLists{}; ///< Cached blocks per size class
+        };
+
+        TaskFramePool &GetTaskFramePool()
+        {
+            thread_local TaskFramePool pool;
+            return pool;
+        }
+    } // namespace
+
+    namespace Detail
+    {
+        void *AllocateTaskFrame(std::size_t size)
+        {
+            return GetTaskFramePool().Allocate(size);
+        }
+
+        void FreeTaskFrame(void *frame, std::size_t size) noexcept
+        {
+            GetTaskFramePool().Free(frame, size);
+        }
+    } // namespace Detail
+
+    TaskScheduler::~TaskScheduler()
+    {
+        for (std::uint32_t slot = 0; slot < tasks.size(); ++slot)
+        {
+            if (tasks[slot].handle)
+            {
+                Release(slot);
+            }
+        }
+    }
+
+    Subscription TaskScheduler::Spawn(Task<> task)
+    {
+        std::uint32_t slot;
+        if (!freeSlots.empty())
+        {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        else
+        {
+            slot = static_cast<std::uint32_t>(tasks.size());
+            tasks.emplace_back();
+        }
+
+        const auto handle = std::exchange(task.handle, {});
+        const auto generation = tasks[slot].generation;
+        handle.promise().context = { this, slot, generation };
+        tasks[slot].handle = handle;
+        taskCount++;
+
+        Resume({ handle, slot, generation });
+        return MakeSubscription(slot, generation);
+    }
+
+    void TaskScheduler::Spawn(Layer &owner, Task<> task)
+    {
+        owner.subscriptions.push_back(Spawn(std::move(task)));
+    }
+
+    void TaskScheduler::Update(float timestep)
+    {
+        time += timestep;
+
+        {
+            std::lock_guard<std::mutex> lock(readyMutex);
+            resuming.swap(ready);
+        }
+
+        while (!timers.empty() && timers.front().wakeTime <= time)
+        {
+            std::pop_heap(timers.begin(), timers.end(), std::greater<>());
+            resuming.push_back(timers.back().resumption);
+            timers.pop_back();
+        }
+
+        for (const auto &resumption : resuming)
+        {
+            Resume(resumption);
+        }
+        resuming.clear();
+    }
+
+    void TaskScheduler::Schedule(std::coroutine_handle<> handle, const Detail::TaskContext &context)
+    {
+        std::lock_guard<std::mutex> lock(readyMutex);
+        ready.push_back({ handle, context.slot, context.generation });
+    }
+
+    void TaskScheduler::ScheduleAfter(
+        double seconds, std::coroutine_handle<> handle, const Detail::TaskContext &context)
+    {
+        timers.push_back({ time + seconds, timerSequence++, { handle, context.slot, context.generation } });
+        std::push_heap(timers.begin(), timers.end(), std::greater<>());
+    }
+
+    bool TaskScheduler::HasReadyTasks()
+    {
+        std::lock_guard<std::mutex> lock(readyMutex);
+        return !ready.empty();
+    }
+
+    double TaskScheduler::GetTimeUntilNextTimer() const
+    {
+        return timers.empty() ? std::numeric_limits<double>::infinity() : timers.front().wakeTime - time;
+    }
+
+    void TaskScheduler::Resume(const Resumption &resumption)
+    {
+        auto &task = tasks[resumption.slot];
+        if (task.generation != resumption.generation || !task.handle || task.finished)
+        {
+            return;
+        }
+
+        task.running = true;
+        resumption.handle.resume();
+        // Spawning from inside the task may have grown the slot map
+        auto &resumed = tasks[resumption.slot];
+        resumed.running = false;
+
+        if (resumed.finished)
+        {
+            const auto promise = std::coroutine_handle<Task<>::promise_type>::from_address(resumed.handle.address());
+            if (const auto exception = promise.promise().exception)
+            {
+                try
+                {
+                    std::rethrow_exception(exception);
+                }
+                catch (const std::exception &error)
+                {
+                    LOG_ERROR("TaskScheduler: Task ended with an exception: {}", error.what());
+                }
+                catch (...)
+                {
+                    LOG_ERROR("TaskScheduler: Task ended with an unknown exception");
+                }
+            }
+            Release(resumption.slot);
+        }
+    }
+
+    void TaskScheduler::OnTaskFinished(std::uint32_t slot)
+    {
+        tasks[slot].finished = true;
+    }
+
+    void TaskScheduler::Release(std::uint32_t slot)
+    {
+        const auto handle = std::exchange(tasks[slot].handle, {});
+        tasks[slot].generation++;
+        tasks[slot].running = false;
+        tasks[slot].finished = false;
+        freeSlots.push_back(slot);
+        taskCount--;
+
+        // Destroying the root frame destroys every awaited child task and the awaiters they hold
+        handle.destroy();
+    }
+
+    void TaskScheduler::Unsubscribe(std::uint32_t slot, std::uint32_t generation)
+    {
+        if (slot >= tasks.size() || tasks[slot].generation != generation || !tasks[slot].handle)
+        {
+            return;
+        }
+
+        if (tasks[slot].running)
+        {
+            // The frame is executing; Resume() releases it once it suspends
+            tasks[slot].finished = true;
+            return;
+        }
+
+        Release(slot);
+    }
+} // namespace Kappa
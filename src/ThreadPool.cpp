@@ -0,0 +1,259 @@
+#include "Kappa/ThreadPool.h"
+
+#include <utility>
+
+namespace Kappa
+{
+    namespace Detail
+    {
+        /**
+         * @brief Shared state of a job with dependencies.
+         * @note The dependency count starts at one, held by Submit() while it registers the job with its
+         *       dependencies, so the job can't start before registration completes.
+         */
+        struct JobState
+        {
+            ThreadPool *pool = nullptr;                           ///< Pool the job runs on
+            ThreadPool::Task task;                                ///< Work, released after running
+            std::atomic<std::size_t> pendingDependencies{ 1 };    ///< Unfinished dependencies plus the setup hold
+            std::atomic<bool> done{ false };                      ///< Set once the task has returned
+            std::mutex mutex;                                     ///< Guards continuations and finished
+            std::vector<std::shared_ptr<JobState>> continuations; ///< Jobs waiting on this one
+            bool finished = false;                                ///< Continuations were released
+        };
+    } // namespace Detail
+
+    namespace
+    {
+        thread_local ThreadPool *currentPool = nullptr; ///< Pool the calling thread works for, if any
+        thread_local std::size_t currentWorker = 0;     ///< Worker index within currentPool
+    } // namespace
+
+    bool JobHandle::IsDone() const
+    {
+        return !state || state->done.load(std::memory_order_acquire);
+    }
+
+    ThreadPool::ThreadPool(std::size_t workerCount)
+    {
+        queues.reserve(workerCount);
+        for (std::size_t i = 0; i < workerCount; ++i)
+        {
+            queues.push_back(std::make_unique<TaskQueue>());
+        }
+
+        workers.reserve(workerCount);
+        for (std::size_t i = 0; i < workerCount; ++i)
+        {
+            workers.emplace_back([this, i] { WorkerLoop(i); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    std::size_t ThreadPool::DefaultWorkerCount()
+    {
+        const auto hardwareThreads = std::thread::hardware_concurrency();
+        return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    void ThreadPool::Submit(Task task)
+    {
+        if (workers.empty())
+        {
+            Invoke(task);
+            return;
+        }
+
+        Push(std::move(task));
+    }
+
+    JobHandle ThreadPool::Submit(Task task, std::span<const JobHandle> dependencies)
+    {
+        auto job = std::make_shared<Detail::JobState>();
+        job->pool = this;
+        job->task = std::move(task);
+
+        for (const auto &dependency : dependencies)
+        {
+            if (!dependency.state)
+            {
+                continue;
+            }
+
+            std::lock_guard<std::mutex> lock(dependency.state->mutex);
+            if (!dependency.state->finished)
+            {
+                job->pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+                dependency.state->continuations.push_back(job);
+            }
+        }
+
+        JobHandle handle(job);
+        ReleaseDependency(job);
+        return handle;
+    }
+
+    void ThreadPool::Wait(const JobHandle &job)
+    {
+        while (!job.IsDone())
+        {
+            if (!TryRunPending())
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    bool ThreadPool::TryRunPending()
+    {
+        Task task;
+        if (!TryTake(task))
+        {
+            return false;
+        }
+
+        Invoke(task);
+        return true;
+    }
+
+    void ThreadPool::Push(Task task)
+    {
+        auto &queue = currentPool == this ? *queues[currentWorker] : injected;
+
+        // Counted before it becomes visible so queuedCount never underflows; a worker seeing the count
+        // early just looks again
+        queuedCount.fetch_add(1);
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+
+        // Pairs with the sleepingWorkers increment in WorkerLoop(): either the worker sees the new count
+        // before sleeping, or this sees the sleeper and wakes it under the mutex
+        if (sleepingWorkers.load() > 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+            }
+            wake.notify_one();
+        }
+    }
+
+    bool ThreadPool::TryTake(Task &task)
+    {
+        const auto takeFrom = [this, &task](TaskQueue &queue, bool newest) {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty())
+            {
+                return false;
+            }
+
+            if (newest)
+            {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            queuedCount.fetch_sub(1);
+            return true;
+        };
+
+        const bool isWorker = currentPool == this;
+        if (isWorker && takeFrom(*queues[currentWorker], true))
+        {
+            return true;
+        }
+
+        if (takeFrom(injected, false))
+        {
+            return true;
+        }
+
+        // Steal the oldest task of another worker, starting with the next one to spread the thieves
+        const auto start = isWorker ? currentWorker + 1 : 0;
+        for (std::size_t i = 0; i < queues.size(); ++i)
+        {
+            const auto victim = (start + i) % queues.size();
+            if ((!isWorker || victim != currentWorker) && takeFrom(*queues[victim], false))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void ThreadPool::Schedule(std::shared_ptr<Detail::JobState> job)
+    {
+        Submit([job = std::move(job)] { RunJob(*job); });
+    }
+
+    void ThreadPool::ReleaseDependency(const std::shared_ptr<Detail::JobState> &job)
+    {
+        if (job->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            job->pool->Schedule(job);
+        }
+    }
+
+    void ThreadPool::RunJob(Detail::JobState &job)
+    {
+        Invoke(job.task);
+        job.task = nullptr;
+
+        std::vector<std::shared_ptr<Detail::JobState>> continuations;
+        {
+            std::lock_guard<std::mutex> lock(job.mutex);
+            job.finished = true;
+            continuations.swap(job.continuations);
+        }
+        job.done.store(true, std::memory_order_release);
+
+        for (const auto &continuation : continuations)
+        {
+            ReleaseDependency(continuation);
+        }
+    }
+
+    void ThreadPool::WorkerLoop(std::size_t index)
+    {
+        currentPool = this;
+        currentWorker = index;
+
+        for (;;)
+        {
+            Task task;
+            if (TryTake(task))
+            {
+                Invoke(task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleepingWorkers.fetch_add(1);
+            wake.wait(lock, [this] { return stopping || queuedCount.load() > 0; });
+            sleepingWorkers.fetch_sub(1);
+            if (stopping && queuedCount.load() == 0)
+            {
+                return;
+            }
+        }
+    }
+} // namespace Kappa
@@ -1,10 +1,16 @@
 #include "Kappa/Application.h"
 #include "Kappa/Layer.h"
+#include "Kappa/Task.h"
 
 #include <GLFW/glfw3.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 using namespace Kappa;
 
@@ -100,6 +106,24 @@ public:
 
 class ApplicationTest : public ::testing::Test
 {
+protected:
+    void SetUp() override
+    {
+        spec.name = "TestApp";
+        spec.windowSpecification.title = "Test Window";
+        spec.windowSpecification.width = 800;
+        spec.windowSpecification.height = 600;
+        spec.headless = true;
+    }
+
+    ApplicationSpecification spec;
+};
+
+/**
+ * @brief Fixture for tests that need a real window and OpenGL context.
+ */
+class WindowedApplicationTest : public ::testing::Test
+{
 protected:
     void SetUp() override
     {
@@ -237,6 +261,288 @@ TEST_F(ApplicationTest, ApplicationHasEventBus)
     EXPECT_NO_THROW(static_cast<void>(app.GetEventBus()));
 }
 
+TEST_F(ApplicationTest, StaticEventBusForwardsUnlistedEvents)
+{
+    class ListedEvent : public Event
+    {
+    };
+    class OtherEvent : public Event
+    {
+    };
+    using AppEventBus = StaticEventBusWithFallback<ListedEvent>;
+
+    class StaticBusApplication : public Application
+    {
+    public:
+        explicit StaticBusApplication(const ApplicationSpecification &spec) : Application(spec)
+        {
+            UseStaticEventBus<AppEventBus>();
+        }
+    };
+
+    StaticBusApplication app(spec);
+    auto &bus = app.GetStaticEventBus<AppEventBus>();
+    int calls = 0;
+    auto subscription = app.GetEventBus().Subscribe<OtherEvent>([&calls](const OtherEvent &) { calls++; });
+
+    bus.Publish(OtherEvent());
+
+    EXPECT_TRUE(app.HasStaticEventBus());
+    EXPECT_EQ(bus.GetFallbackBus(), &app.GetEventBus());
+    EXPECT_EQ(calls, 1);
+}
+
+TEST_F(ApplicationTest, HandlerCreatingChannelsDuringDrain)
+{
+    class ChannelEvent : public Event
+    {
+    public:
+        explicit ChannelEvent(int value) : value(value)
+        {
+        }
+        int value;
+    };
+
+    spec.maxFrames = 3;
+    TestApplication app(spec);
+    std::vector<std::shared_ptr<EventChannel<ChannelEvent>>> created;
+    std::vector<int> received;
+    auto subscription = app.GetEventBus().Subscribe<ChannelEvent>([&](const ChannelEvent &event) {
+        received.push_back(event.value);
+        if (event.value == 1)
+        {
+            // Enough channels to reallocate the application's channel list mid-drain
+            for (int i = 0; i < 8; ++i)
+            {
+                created.push_back(app.CreateEventChannel<ChannelEvent>());
+            }
+            EXPECT_TRUE(created.back()->Push(ChannelEvent(2)));
+        }
+    });
+    // A second channel after the first keeps the drain loop going once the list has grown
+    const auto first = app.CreateEventChannel<ChannelEvent>();
+    const auto second = app.CreateEventChannel<ChannelEvent>();
+    EXPECT_TRUE(first->Push(ChannelEvent(1)));
+
+    app.Run();
+
+    EXPECT_EQ(received, (std::vector<int>{ 1, 2 }));
+}
+
+TEST_F(ApplicationTest, GetEventStreamReturnsSameStreamPerType)
+{
+    TestApplication app(spec);
+
+    auto &ints = app.GetEventStream<int>();
+    ints.Push(1);
+
+    EXPECT_EQ(&app.GetEventStream<int>(), &ints);
+    EXPECT_NE(static_cast<void *>(&app.GetEventStream<float>()), static_cast<void *>(&ints));
+    EXPECT_EQ(app.GetEventStream<int>().GetPendingCount(), 1u);
+}
+
+TEST_F(ApplicationTest, FixedTimestepFollowsSpecification)
+{
+    {
+        TestApplication app(spec);
+        EXPECT_EQ(app.GetFixedTimestep(), nullptr);
+        EXPECT_EQ(app.GetInterpolationAlpha(), 1.0f);
+    }
+
+    spec.fixedTimestep = 1.0f / 60.0f;
+    spec.maxFixedStepsPerFrame = 4;
+    TestApplication app(spec);
+
+    ASSERT_NE(app.GetFixedTimestep(), nullptr);
+    EXPECT_FLOAT_EQ(app.GetFixedTimestep()->GetStepSize(), 1.0f / 60.0f);
+    EXPECT_EQ(app.GetFixedTimestep()->GetMaxSteps(), 4);
+    EXPECT_EQ(app.GetInterpolationAlpha(), 0.0f);
+}
+
+namespace
+{
+    class IdleCountingLayer : public Layer
+    {
+    public:
+        IdleCountingLayer(int *updates, float *longestTimestep) : updates(updates), longestTimestep(longestTimestep)
+        {
+        }
+
+        void OnEvent(Event &event) override
+        {
+        }
+        void OnUpdate(float deltaTime) override
+        {
+            if ((*updates)++ == 0)
+            {
+                // The only wake-up source besides window events: stop after a delay
+                auto stopLater = []() -> Task<> {
+                    co_await Delay(0.2);
+                    Application::Get().Stop();
+                };
+                Application::Get().GetTaskScheduler().Spawn(*this, stopLater());
+            }
+            *longestTimestep = std::max(*longestTimestep, deltaTime);
+        }
+        void OnRender() override
+        {
+        }
+
+        int *updates;
+        float *longestTimestep;
+    };
+} // namespace
+
+TEST_F(WindowedApplicationTest, ReactiveRenderingSkipsIdleFrames)
+{
+    spec.reactiveRendering = true;
+    spec.idleTimeout = 0.05f;
+    int updates = 0;
+    float longestTimestep = 0.0f;
+    TestApplication app(spec);
+    app.TestPushLayer<IdleCountingLayer>(&updates, &longestTimestep);
+
+    const auto start = std::chrono::steady_clock::now();
+    app.Run();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // A continuous loop would run dozens of frames in 200 ms; idle waits skip all but a few
+    EXPECT_GE(elapsed, std::chrono::milliseconds(200));
+    EXPECT_LE(updates, 5);
+    // Blocked time isn't passed on as a timestep
+    EXPECT_LT(longestTimestep, 0.1f);
+}
+
+// ============================================================================
+// Headless Tests
+// ============================================================================
+
+namespace
+{
+    struct FrameCounts
+    {
+        int updates = 0;
+        int renders = 0;
+        float lastTimestep = 0.0f;
+    };
+
+    class FrameCountingLayer : public Layer
+    {
+    public:
+        explicit FrameCountingLayer(FrameCounts *counts) : counts(counts)
+        {
+        }
+
+        void OnEvent(Event &event) override
+        {
+        }
+        void OnUpdate(float deltaTime) override
+        {
+            counts->updates++;
+            counts->lastTimestep = deltaTime;
+        }
+        void OnRender() override
+        {
+            counts->renders++;
+        }
+
+        FrameCounts *counts;
+    };
+} // namespace
+
+TEST_F(ApplicationTest, HeadlessRunsUpdatesWithoutRendering)
+{
+    spec.maxFrames = 10;
+    FrameCounts counts;
+    TestApplication app(spec);
+    app.TestPushLayer<FrameCountingLayer>(&counts);
+
+    EXPECT_TRUE(app.IsHeadless());
+
+    app.Run();
+
+    EXPECT_EQ(counts.updates, 10);
+    EXPECT_EQ(counts.renders, 0);
+    EXPECT_EQ(app.GetFrameCount(), 10u);
+    EXPECT_EQ(app.GetFramePacingStats().frameCount, 10u);
+}
+
+TEST_F(ApplicationTest, HeadlessRenderCallsOnRender)
+{
+    spec.maxFrames = 5;
+    spec.headlessRender = true;
+    FrameCounts counts;
+    TestApplication app(spec);
+    app.TestPushLayer<FrameCountingLayer>(&counts);
+
+    app.Run();
+
+    EXPECT_EQ(counts.updates, 5);
+    EXPECT_EQ(counts.renders, 5);
+}
+
+TEST_F(ApplicationTest, HeadlessTimestepIsFixed)
+{
+    spec.maxFrames = 30;
+    spec.headlessTimestep = 1.0f / 60.0f;
+    FrameCounts counts;
+    TestApplication app(spec);
+    app.TestPushLayer<FrameCountingLayer>(&counts);
+
+    app.Run();
+
+    // Simulated time follows the timestep, not the wall clock, so the batch finishes far sooner than 0.5 s
+    EXPECT_FLOAT_EQ(counts.lastTimestep, 1.0f / 60.0f);
+    EXPECT_NEAR(app.GetTaskScheduler().GetTime(), 0.5, 1e-4);
+}
+
+TEST_F(ApplicationTest, HeadlessHonoursTargetFrameRate)
+{
+    spec.maxFrames = 20;
+    spec.targetFrameRate = 200.0f;
+    TestApplication app(spec);
+
+    const auto start = std::chrono::steady_clock::now();
+    app.Run();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // The first frame ends on the first deadline, so 20 frames take at least 19 periods
+    EXPECT_GE(elapsed, std::chrono::milliseconds(95));
+    EXPECT_GT(app.GetFramePacingStats().GetFramesPerSecond(), 100.0);
+}
+
+TEST_F(ApplicationTest, SetupTimeIsNotAMissedFrame)
+{
+    spec.maxFrames = 5;
+    spec.targetFrameRate = 100.0f;
+    TestApplication app(spec);
+
+    // Stands in for asset loading between construction and Run()
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    app.Run();
+
+    const auto stats = app.GetFramePacingStats();
+    EXPECT_EQ(stats.missedFrames, 0u);
+    EXPECT_LT(stats.maxFrameNanoseconds, 40'000'000u);
+}
+
+TEST_F(ApplicationTest, StopEndsHeadlessRun)
+{
+    TestApplication app(spec);
+    auto stopAfterThreeFrames = []() -> Task<> {
+        for (int frame = 0; frame < 3; ++frame)
+        {
+            co_await NextFrame();
+        }
+        Application::Get().Stop();
+    };
+    const auto task = app.GetTaskScheduler().Spawn(stopAfterThreeFrames());
+
+    app.Run();
+
+    EXPECT_EQ(app.GetFrameCount(), 3u);
+}
+
 // ============================================================================
 // Application::Get() Tests
 // ============================================================================
@@ -250,6 +556,54 @@ TEST_F(ApplicationTest, GetReturnsCorrectInstance)
     EXPECT_EQ(&instance, &app);
 }
 
+TEST_F(ApplicationTest, SecondInstanceOnSameThreadThrows)
+{
+    TestApplication app(spec);
+
+    EXPECT_THROW(TestApplication second(spec), std::logic_error);
+    EXPECT_EQ(&Application::Get(), &app);
+}
+
+TEST_F(ApplicationTest, InstancesOnOtherThreadsAreIndependent)
+{
+    TestApplication app(spec);
+
+    Application *seenOnThread = nullptr;
+    Application *currentAfterThread = &app;
+    std::thread thread([this, &seenOnThread, &currentAfterThread] {
+        {
+            TestApplication other(spec);
+            seenOnThread = &Application::Get();
+            EXPECT_EQ(seenOnThread, &other);
+        }
+        currentAfterThread = Application::TryGet();
+    });
+    thread.join();
+
+    EXPECT_NE(seenOnThread, &app);
+    EXPECT_EQ(currentAfterThread, nullptr);
+    EXPECT_EQ(&Application::Get(), &app);
+}
+
+TEST_F(ApplicationTest, RunMakesInstanceCurrentOnRunningThread)
+{
+    spec.maxFrames = 1;
+    auto app = std::make_unique<TestApplication>(spec);
+
+    Application *seenWhileRunning = nullptr;
+    auto observe = [&seenWhileRunning]() -> Task<> {
+        co_await NextFrame();
+        seenWhileRunning = Application::TryGet();
+    };
+    std::thread thread([&app, &observe] {
+        const auto task = app->GetTaskScheduler().Spawn(observe());
+        app->Run();
+    });
+    thread.join();
+
+    EXPECT_EQ(seenWhileRunning, app.get());
+}
+
 // ============================================================================
 // Multiple Layers Stress Tests
 // ============================================================================
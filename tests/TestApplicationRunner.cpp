@@ -0,0 +1,158 @@
+#include "Kappa/ApplicationRunner.h"
+#include "Kappa/Layer.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace Kappa;
+
+namespace
+{
+    /**
+     * @brief Layer that checks Application::Get() refers to its own instance on every update.
+     */
+    class SweepLayer : public Layer
+    {
+    public:
+        SweepLayer(Application *expected, std::atomic<int> *mismatches) : expected(expected), mismatches(mismatches)
+        {
+        }
+
+        void OnEvent(Event &event) override
+        {
+        }
+        void OnUpdate(float deltaTime) override
+        {
+            if (&Application::Get() != expected)
+            {
+                mismatches->fetch_add(1);
+            }
+        }
+        void OnRender() override
+        {
+        }
+
+    private:
+        Application *expected;
+        std::atomic<int> *mismatches;
+    };
+
+    class SweepApplication : public Application
+    {
+    public:
+        SweepApplication(const ApplicationSpecification &spec, std::atomic<int> *mismatches) : Application(spec)
+        {
+            PushLayer<SweepLayer>(this, mismatches);
+        }
+    };
+
+    ApplicationSpecification MakeSweepSpecification(std::uint64_t frames)
+    {
+        ApplicationSpecification spec;
+        spec.name = "Sweep";
+        spec.headless = true;
+        spec.headlessTimestep = 1.0f / 60.0f;
+        spec.maxFrames = frames;
+        return spec;
+    }
+} // namespace
+
+// ============================================================================
+// ApplicationRunner Tests
+// ============================================================================
+
+TEST(ApplicationRunnerTest, RunsEveryInstanceAndCollectsStats)
+{
+    ApplicationRunner runner(4);
+    std::atomic<int> mismatches{ 0 };
+
+    const auto results = runner.Run(16, [&mismatches](std::size_t index) -> std::unique_ptr<Application> {
+        return std::make_unique<SweepApplication>(MakeSweepSpecification(10 + index), &mismatches);
+    });
+
+    ASSERT_EQ(results.size(), 16u);
+    for (std::size_t index = 0; index < results.size(); ++index)
+    {
+        EXPECT_EQ(results[index].index, index);
+        EXPECT_TRUE(results[index].succeeded) << results[index].error;
+        EXPECT_EQ(results[index].frameCount, 10 + index);
+        EXPECT_EQ(results[index].pacing.frameCount, 10 + index);
+    }
+    EXPECT_EQ(mismatches.load(), 0);
+}
+
+TEST(ApplicationRunnerTest, ReportsFailuresPerInstance)
+{
+    ApplicationRunner runner(2);
+    std::atomic<int> mismatches{ 0 };
+
+    const auto results = runner.Run(3, [&mismatches](std::size_t index) -> std::unique_ptr<Application> {
+        if (index == 1)
+        {
+            throw std::runtime_error("bad parameters");
+        }
+        return std::make_unique<SweepApplication>(MakeSweepSpecification(5), &mismatches);
+    });
+
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_TRUE(results[0].succeeded);
+    EXPECT_FALSE(results[1].succeeded);
+    EXPECT_EQ(results[1].error, "bad parameters");
+    EXPECT_TRUE(results[2].succeeded);
+}
+
+TEST(ApplicationRunnerTest, RejectsMissingApplication)
+{
+    ApplicationRunner runner(1);
+
+    const auto results = runner.Run(1, [](std::size_t) -> std::unique_ptr<Application> { return nullptr; });
+
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_FALSE(results[0].succeeded);
+    EXPECT_FALSE(results[0].error.empty());
+}
+
+TEST(ApplicationRunnerTest, InstancesWithoutAWorkerCountRunJobsInline)
+{
+    ApplicationRunner runner(2);
+    std::atomic<int> mismatches{ 0 };
+    std::vector<std::size_t> workerCounts(2);
+
+    const auto results = runner.Run(2, [&](std::size_t index) -> std::unique_ptr<Application> {
+        auto spec = MakeSweepSpecification(1);
+        if (index == 1)
+        {
+            spec.workerThreadCount = 3;
+        }
+        auto application = std::make_unique<SweepApplication>(spec, &mismatches);
+        workerCounts[index] = application->GetThreadPool().GetWorkerCount();
+        return application;
+    });
+
+    // The default is resolved per thread; an explicit count is honoured
+    EXPECT_EQ(workerCounts, (std::vector<std::size_t>{ 0, 3 }));
+    EXPECT_FALSE(ApplicationRunner::IsRunningInstance());
+    SweepApplication standalone(MakeSweepSpecification(1), &mismatches);
+    EXPECT_EQ(standalone.GetThreadPool().GetWorkerCount(), ThreadPool::DefaultWorkerCount());
+}
+
+TEST(ApplicationRunnerTest, CallerKeepsItsOwnApplication)
+{
+    std::atomic<int> mismatches{ 0 };
+    SweepApplication host(MakeSweepSpecification(1), &mismatches);
+    ApplicationRunner runner(2);
+
+    const auto results = runner.Run(4, [&mismatches](std::size_t) -> std::unique_ptr<Application> {
+        return std::make_unique<SweepApplication>(MakeSweepSpecification(3), &mismatches);
+    });
+
+    EXPECT_EQ(&Application::Get(), &host);
+    for (const auto &result : results)
+    {
+        EXPECT_TRUE(result.succeeded);
+    }
+}
@@ -1,9 +1,20 @@
 #include "Kappa/Event.h"
 #include "Kappa/EventBus.h"
+#include "Kappa/Layer.h"
+#include "Kappa/ThreadPool.h"
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <span>
 #include <string>
+#include <thread>
+#include <vector>
 
 using namespace Kappa;
 
@@ -33,6 +44,26 @@ class EmptyEvent : public Event
 {
 };
 
+class InputEvent : public DerivedEvent<InputEvent>
+{
+};
+
+class KeyEvent : public DerivedEvent<KeyEvent, InputEvent>
+{
+public:
+    explicit KeyEvent(int keyCode) : key(keyCode)
+    {
+    }
+    int key;
+};
+
+// Doesn't declare its own parent; dispatch continues from KeyEvent
+class RepeatedKeyEvent : public KeyEvent
+{
+public:
+    using KeyEvent::KeyEvent;
+};
+
 // ============================================================================
 // EventBus Tests
 // ============================================================================
@@ -41,6 +72,7 @@ class EventBusTest : public ::testing::Test
 {
 protected:
     EventBus eventBus;
+    std::vector<Subscription> subscriptions; // Destroyed before the bus
 };
 
 // ============================================================================
@@ -51,7 +83,8 @@ TEST_F(EventBusTest, SubscribeAndPublishSingleEvent)
 {
     int receivedValue = 0;
 
-    eventBus.Subscribe<TestEvent>([&receivedValue](const TestEvent &event) { receivedValue = event.value; });
+    subscriptions.push_back(
+        eventBus.Subscribe<TestEvent>([&receivedValue](const TestEvent &event) { receivedValue = event.value; }));
 
     TestEvent event(42);
     eventBus.Publish(event);
@@ -64,9 +97,9 @@ TEST_F(EventBusTest, SubscribeMultipleHandlersSameEvent)
     int count = 0;
     int sum = 0;
 
-    eventBus.Subscribe<TestEvent>([&count](const TestEvent &) { count++; });
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>([&count](const TestEvent &) { count++; }));
 
-    eventBus.Subscribe<TestEvent>([&sum](const TestEvent &event) { sum += event.value; });
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>([&sum](const TestEvent &event) { sum += event.value; }));
 
     TestEvent event(10);
     eventBus.Publish(event);
@@ -85,9 +118,11 @@ TEST_F(EventBusTest, SubscribeDifferentEventTypes)
     int intValue = 0;
     std::string stringValue;
 
-    eventBus.Subscribe<TestEvent>([&intValue](const TestEvent &event) { intValue = event.value; });
+    subscriptions.push_back(
+        eventBus.Subscribe<TestEvent>([&intValue](const TestEvent &event) { intValue = event.value; }));
 
-    eventBus.Subscribe<StringEvent>([&stringValue](const StringEvent &event) { stringValue = event.message; });
+    subscriptions.push_back(
+        eventBus.Subscribe<StringEvent>([&stringValue](const StringEvent &event) { stringValue = event.message; }));
 
     TestEvent intEvent(123);
     StringEvent strEvent("Hello");
@@ -111,7 +146,7 @@ TEST_F(EventBusTest, EmptyEventHandling)
 {
     bool called = false;
 
-    eventBus.Subscribe<EmptyEvent>([&called](const EmptyEvent &) { called = true; });
+    subscriptions.push_back(eventBus.Subscribe<EmptyEvent>([&called](const EmptyEvent &) { called = true; }));
 
     EmptyEvent event;
     eventBus.Publish(event);
@@ -127,7 +162,8 @@ TEST_F(EventBusTest, PublishMultipleEvents)
 {
     std::vector<int> values;
 
-    eventBus.Subscribe<TestEvent>([&values](const TestEvent &event) { values.push_back(event.value); });
+    subscriptions.push_back(
+        eventBus.Subscribe<TestEvent>([&values](const TestEvent &event) { values.push_back(event.value); }));
 
     for (int i = 0; i < 10; ++i)
     {
@@ -151,8 +187,8 @@ TEST_F(EventBusTest, LambdaCaptureByValue)
     int capturedValue = 100;
     int receivedValue = 0;
 
-    eventBus.Subscribe<TestEvent>(
-        [capturedValue, &receivedValue](const TestEvent &event) { receivedValue = event.value + capturedValue; });
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>(
+        [capturedValue, &receivedValue](const TestEvent &event) { receivedValue = event.value + capturedValue; }));
 
     TestEvent event(50);
     eventBus.Publish(event);
@@ -164,7 +200,7 @@ TEST_F(EventBusTest, LambdaCaptureByReference)
 {
     int counter = 0;
 
-    eventBus.Subscribe<TestEvent>([&counter](const TestEvent &) { counter++; });
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>([&counter](const TestEvent &) { counter++; }));
 
     for (int i = 0; i < 5; ++i)
     {
@@ -183,11 +219,11 @@ TEST_F(EventBusTest, HandlersCalledInSubscriptionOrder)
 {
     std::vector<int> order;
 
-    eventBus.Subscribe<TestEvent>([&order](const TestEvent &) { order.push_back(1); });
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>([&order](const TestEvent &) { order.push_back(1); }));
 
-    eventBus.Subscribe<TestEvent>([&order](const TestEvent &) { order.push_back(2); });
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>([&order](const TestEvent &) { order.push_back(2); }));
 
-    eventBus.Subscribe<TestEvent>([&order](const TestEvent &) { order.push_back(3); });
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>([&order](const TestEvent &) { order.push_back(3); }));
 
     TestEvent event(0);
     eventBus.Publish(event);
@@ -204,11 +240,11 @@ TEST_F(EventBusTest, HandlersCalledInSubscriptionOrder)
 
 TEST_F(EventBusTest, EventIsConstInHandler)
 {
-    eventBus.Subscribe<TestEvent>([](const TestEvent &event) {
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>([](const TestEvent &event) {
         // This should compile - event is const
         int val = event.value;
         (void)val; // Suppress unused warning
-    });
+    }));
 
     TestEvent event(100);
     EXPECT_NO_THROW(eventBus.Publish(event));
@@ -231,11 +267,11 @@ TEST_F(EventBusTest, EventWithComplexData)
     std::string receivedName;
     double receivedCoeff = 0.0;
 
-    eventBus.Subscribe<ComplexEvent>([&](const ComplexEvent &event) {
+    subscriptions.push_back(eventBus.Subscribe<ComplexEvent>([&](const ComplexEvent &event) {
         receivedNumbers = event.numbers;
         receivedName = event.name;
         receivedCoeff = event.coefficient;
-    });
+    }));
 
     ComplexEvent event;
     event.numbers = { 1, 2, 3, 4, 5 };
@@ -248,3 +284,922 @@ TEST_F(EventBusTest, EventWithComplexData)
     EXPECT_EQ(receivedName, "TestComplex");
     EXPECT_DOUBLE_EQ(receivedCoeff, 3.14159);
 }
+
+// ============================================================================
+// Re-entrancy Tests
+// ============================================================================
+
+TEST_F(EventBusTest, SubscribeFromHandlerTakesEffectOnNextPublish)
+{
+    int outerCalls = 0;
+    int innerCalls = 0;
+
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>([&](const TestEvent &) {
+        if (outerCalls++ == 0)
+        {
+            subscriptions.push_back(eventBus.Subscribe<TestEvent>([&innerCalls](const TestEvent &) { innerCalls++; }));
+        }
+    }));
+
+    eventBus.Publish(TestEvent(1));
+    EXPECT_EQ(outerCalls, 1);
+    EXPECT_EQ(innerCalls, 0);
+
+    eventBus.Publish(TestEvent(2));
+    EXPECT_EQ(outerCalls, 2);
+    EXPECT_EQ(innerCalls, 1);
+}
+
+TEST_F(EventBusTest, ClearFromHandlerFinishesCurrentPublish)
+{
+    int calls = 0;
+
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>([&](const TestEvent &) {
+        calls++;
+        eventBus.Clear();
+    }));
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>([&calls](const TestEvent &) { calls++; }));
+
+    eventBus.Publish(TestEvent(1));
+    EXPECT_EQ(calls, 2);
+
+    eventBus.Publish(TestEvent(2));
+    EXPECT_EQ(calls, 2);
+}
+
+// ============================================================================
+// Subscription Handle Tests
+// ============================================================================
+
+TEST_F(EventBusTest, DestroyingSubscriptionRemovesHandler)
+{
+    int calls = 0;
+    {
+        const auto subscription = eventBus.Subscribe<TestEvent>([&calls](const TestEvent &) { calls++; });
+        eventBus.Publish(TestEvent(1));
+    }
+
+    eventBus.Publish(TestEvent(2));
+    EXPECT_EQ(calls, 1);
+}
+
+TEST_F(EventBusTest, ResetRemovesOnlyThatHandlerAndKeepsOrder)
+{
+    std::vector<int> order;
+    auto first = eventBus.Subscribe<TestEvent>([&order](const TestEvent &) { order.push_back(1); });
+    auto second = eventBus.Subscribe<TestEvent>([&order](const TestEvent &) { order.push_back(2); });
+    auto third = eventBus.Subscribe<TestEvent>([&order](const TestEvent &) { order.push_back(3); });
+
+    second.Reset();
+    EXPECT_FALSE(second.IsValid());
+
+    eventBus.Publish(TestEvent(0));
+    EXPECT_EQ(order, std::vector<int>({ 1, 3 }));
+
+    // Removing after a shift must still find the right handler
+    third.Reset();
+    order.clear();
+    eventBus.Publish(TestEvent(0));
+    EXPECT_EQ(order, std::vector<int>({ 1 }));
+}
+
+TEST_F(EventBusTest, MovedSubscriptionKeepsHandlerAlive)
+{
+    int calls = 0;
+    Subscription outer;
+    {
+        auto inner = eventBus.Subscribe<TestEvent>([&calls](const TestEvent &) { calls++; });
+        outer = std::move(inner);
+        EXPECT_FALSE(inner.IsValid());
+    }
+
+    eventBus.Publish(TestEvent(1));
+    EXPECT_EQ(calls, 1);
+
+    outer = Subscription();
+    eventBus.Publish(TestEvent(2));
+    EXPECT_EQ(calls, 1);
+}
+
+TEST_F(EventBusTest, StaleSubscriptionAfterClearDoesNotRemoveReusedSlot)
+{
+    int oldCalls = 0;
+    int newCalls = 0;
+    auto stale = eventBus.Subscribe<TestEvent>([&oldCalls](const TestEvent &) { oldCalls++; });
+
+    eventBus.Clear();
+    auto fresh = eventBus.Subscribe<TestEvent>([&newCalls](const TestEvent &) { newCalls++; });
+
+    // The fresh subscription reuses the slot; the stale token's generation no longer matches
+    stale.Reset();
+    eventBus.Publish(TestEvent(1));
+
+    EXPECT_EQ(oldCalls, 0);
+    EXPECT_EQ(newCalls, 1);
+}
+
+TEST_F(EventBusTest, UnsubscribeFromInsideHandler)
+{
+    int calls = 0;
+    Subscription subscription;
+    subscription = eventBus.Subscribe<TestEvent>([&](const TestEvent &) {
+        calls++;
+        subscription.Reset();
+    });
+
+    eventBus.Publish(TestEvent(1));
+    eventBus.Publish(TestEvent(2));
+    EXPECT_EQ(calls, 1);
+}
+
+TEST_F(EventBusTest, LayerScopedSubscriptionEndsWithLayer)
+{
+    class ListeningLayer : public Layer
+    {
+    public:
+        ListeningLayer(EventBus &bus, int &calls)
+        {
+            bus.Subscribe<TestEvent>(*this, [&calls](const TestEvent &) { calls++; });
+        }
+    };
+
+    int calls = 0;
+    auto layer = std::make_unique<ListeningLayer>(eventBus, calls);
+
+    eventBus.Publish(TestEvent(1));
+    EXPECT_EQ(calls, 1);
+
+    layer.reset();
+    eventBus.Publish(TestEvent(2));
+    EXPECT_EQ(calls, 1);
+}
+
+// ============================================================================
+// Deferred Dispatch Tests
+// ============================================================================
+
+TEST_F(EventBusTest, EnqueuedEventsWaitForDispatch)
+{
+    std::vector<int> values;
+    subscriptions.push_back(
+        eventBus.Subscribe<TestEvent>([&values](const TestEvent &event) { values.push_back(event.value); }));
+
+    eventBus.Enqueue<TestEvent>(1);
+    eventBus.Enqueue<TestEvent>(2);
+    EXPECT_TRUE(values.empty());
+
+    eventBus.DispatchQueued();
+    EXPECT_EQ(values, std::vector<int>({ 1, 2 }));
+
+    eventBus.DispatchQueued();
+    EXPECT_EQ(values, std::vector<int>({ 1, 2 }));
+}
+
+TEST_F(EventBusTest, HandlerEnqueuingANewTypeDuringDispatch)
+{
+    class FirstSeenEvent : public Event
+    {
+    };
+    class FirstSeenCoalescedEvent : public Event
+    {
+    };
+
+    int followUps = 0;
+    subscriptions.push_back(eventBus.Subscribe<StringEvent>([this](const StringEvent &) {
+        // Neither type has a queue yet, so this grows the bus's queue list mid-dispatch
+        eventBus.Enqueue<FirstSeenEvent>();
+        eventBus.Coalesce(FirstSeenCoalescedEvent());
+    }));
+    subscriptions.push_back(eventBus.Subscribe<FirstSeenEvent>([&followUps](const FirstSeenEvent &) { followUps++; }));
+    subscriptions.push_back(
+        eventBus.Subscribe<FirstSeenCoalescedEvent>([&followUps](const FirstSeenCoalescedEvent &) { followUps++; }));
+
+    // The trigger's queue comes first, so dispatch still has queues to visit after the list grows
+    eventBus.Enqueue<StringEvent>("trigger");
+    eventBus.Enqueue<TestEvent>(1);
+    eventBus.Enqueue<EmptyEvent>();
+    eventBus.DispatchQueued();
+    EXPECT_EQ(followUps, 0);
+
+    eventBus.DispatchQueued();
+    EXPECT_EQ(followUps, 2);
+}
+
+TEST_F(EventBusTest, DispatchQueuedGroupsEventsByType)
+{
+    std::vector<std::string> order;
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>(
+        [&order](const TestEvent &event) { order.push_back("int" + std::to_string(event.value)); }));
+    subscriptions.push_back(
+        eventBus.Subscribe<StringEvent>([&order](const StringEvent &event) { order.push_back(event.message); }));
+
+    eventBus.Enqueue<TestEvent>(1);
+    eventBus.Enqueue<StringEvent>("a");
+    eventBus.Enqueue<TestEvent>(2);
+    eventBus.Enqueue<StringEvent>("b");
+    eventBus.DispatchQueued();
+
+    EXPECT_EQ(order, std::vector<std::string>({ "int1", "int2", "a", "b" }));
+}
+
+TEST_F(EventBusTest, EventsEnqueuedDuringDispatchWaitForNextDispatch)
+{
+    int received = 0;
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>([&](const TestEvent &event) {
+        received++;
+        if (event.value < 3)
+        {
+            eventBus.Enqueue<TestEvent>(event.value + 1);
+        }
+    }));
+
+    eventBus.Enqueue<TestEvent>(1);
+    eventBus.DispatchQueued();
+    EXPECT_EQ(received, 1);
+
+    eventBus.DispatchQueued();
+    eventBus.DispatchQueued();
+    EXPECT_EQ(received, 3);
+}
+
+// ============================================================================
+// Coalescing Tests
+// ============================================================================
+
+TEST_F(EventBusTest, CoalescedEventsDeliverLatestValueOncePerDispatch)
+{
+    std::vector<int> received;
+    subscriptions.push_back(
+        eventBus.Subscribe<TestEvent>([&received](const TestEvent &event) { received.push_back(event.value); }));
+
+    for (int i = 1; i <= 1000; ++i)
+    {
+        eventBus.Coalesce(TestEvent(i));
+    }
+    EXPECT_TRUE(received.empty());
+
+    eventBus.DispatchQueued();
+    EXPECT_EQ(received, (std::vector<int>{ 1000 }));
+
+    eventBus.DispatchQueued();
+    EXPECT_EQ(received.size(), 1u);
+}
+
+TEST_F(EventBusTest, KeyedCoalescingKeepsLatestValuePerKeyInFirstSeenOrder)
+{
+    std::vector<int> received;
+    subscriptions.push_back(
+        eventBus.Subscribe<TestEvent>([&received](const TestEvent &event) { received.push_back(event.value); }));
+
+    eventBus.Coalesce(7, TestEvent(70));
+    eventBus.Coalesce(3, TestEvent(30));
+    eventBus.Coalesce(7, TestEvent(71));
+    eventBus.Coalesce(3, TestEvent(31));
+    eventBus.Coalesce(9, TestEvent(90));
+    eventBus.DispatchQueued();
+
+    EXPECT_EQ(received, (std::vector<int>{ 71, 31, 90 }));
+}
+
+TEST_F(EventBusTest, KeyedCoalescingHandlesManyKeysAcrossFrames)
+{
+    std::vector<int> received;
+    subscriptions.push_back(
+        eventBus.Subscribe<TestEvent>([&received](const TestEvent &event) { received.push_back(event.value); }));
+
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        // Later frames use fewer keys, so stale slots from the busiest frame must not resurface
+        const int keyCount = 1000 >> frame;
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            for (int key = 0; key < keyCount; ++key)
+            {
+                eventBus.Coalesce(static_cast<std::uint64_t>(key) << 32, TestEvent(key * 10 + pass));
+            }
+        }
+
+        received.clear();
+        eventBus.DispatchQueued();
+
+        ASSERT_EQ(received.size(), static_cast<std::size_t>(keyCount));
+        for (int key = 0; key < keyCount; ++key)
+        {
+            ASSERT_EQ(received[key], key * 10 + 1) << "frame " << frame;
+        }
+    }
+}
+
+TEST_F(EventBusTest, KeyedCoalescingReachesHandlersOfThatKey)
+{
+    std::vector<int> keyed;
+    std::vector<int> otherKey;
+    std::vector<int> wildcard;
+    subscriptions.push_back(
+        eventBus.Subscribe<TestEvent>(7, [&keyed](const TestEvent &event) { keyed.push_back(event.value); }));
+    subscriptions.push_back(
+        eventBus.Subscribe<TestEvent>(3, [&otherKey](const TestEvent &event) { otherKey.push_back(event.value); }));
+    subscriptions.push_back(
+        eventBus.Subscribe<TestEvent>([&wildcard](const TestEvent &event) { wildcard.push_back(event.value); }));
+
+    eventBus.Coalesce(7, TestEvent(70));
+    eventBus.Coalesce(7, TestEvent(71));
+    eventBus.Coalesce(9, TestEvent(90));
+    eventBus.Coalesce(TestEvent(1));
+    eventBus.DispatchQueued();
+
+    // Keyed values go to their key's handlers and the wildcards, the unkeyed value to the wildcards only
+    EXPECT_EQ(keyed, (std::vector<int>{ 71 }));
+    EXPECT_TRUE(otherKey.empty());
+    EXPECT_EQ(wildcard, (std::vector<int>{ 1, 71, 90 }));
+}
+
+TEST_F(EventBusTest, CoalescedEventsFollowEnqueuedEventsOfSameType)
+{
+    std::vector<int> received;
+    subscriptions.push_back(
+        eventBus.Subscribe<TestEvent>([&received](const TestEvent &event) { received.push_back(event.value); }));
+
+    eventBus.Coalesce(TestEvent(1));
+    eventBus.Enqueue<TestEvent>(2);
+    eventBus.Coalesce(TestEvent(3));
+    eventBus.DispatchQueued();
+
+    EXPECT_EQ(received, (std::vector<int>{ 2, 3 }));
+}
+
+TEST_F(EventBusTest, CoalescingDuringDispatchWaitsForNextDispatch)
+{
+    std::vector<int> received;
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>([&](const TestEvent &event) {
+        received.push_back(event.value);
+        eventBus.Coalesce(TestEvent(event.value + 1));
+    }));
+
+    eventBus.Coalesce(TestEvent(1));
+    eventBus.DispatchQueued();
+    eventBus.DispatchQueued();
+
+    EXPECT_EQ(received, (std::vector<int>{ 1, 2 }));
+}
+
+// ============================================================================
+// Batch Tests
+// ============================================================================
+
+TEST_F(EventBusTest, BatchHandlerReceivesWholeSpan)
+{
+    std::vector<std::size_t> batchSizes;
+    int sum = 0;
+    subscriptions.push_back(eventBus.SubscribeBatch<TestEvent>([&](std::span<const TestEvent> events) {
+        batchSizes.push_back(events.size());
+        for (const auto &event : events)
+        {
+            sum += event.value;
+        }
+    }));
+
+    const std::vector<TestEvent> events = { TestEvent(1), TestEvent(2), TestEvent(3) };
+    eventBus.PublishBatch(std::span<const TestEvent>(events));
+
+    EXPECT_EQ(batchSizes, std::vector<std::size_t>({ 3 }));
+    EXPECT_EQ(sum, 6);
+}
+
+TEST_F(EventBusTest, PerEventHandlerReceivesEachBatchedEvent)
+{
+    std::vector<int> values;
+    subscriptions.push_back(
+        eventBus.Subscribe<TestEvent>([&values](const TestEvent &event) { values.push_back(event.value); }));
+
+    const std::vector<TestEvent> events = { TestEvent(1), TestEvent(2), TestEvent(3) };
+    eventBus.PublishBatch(std::span<const TestEvent>(events));
+
+    EXPECT_EQ(values, std::vector<int>({ 1, 2, 3 }));
+}
+
+TEST_F(EventBusTest, BatchHandlerReceivesSingleEventPublishAsSpanOfOne)
+{
+    std::vector<std::size_t> batchSizes;
+    subscriptions.push_back(eventBus.SubscribeBatch<TestEvent>(
+        [&batchSizes](std::span<const TestEvent> events) { batchSizes.push_back(events.size()); }));
+
+    eventBus.Publish(TestEvent(1));
+    eventBus.PublishBatch(std::span<const TestEvent>());
+
+    EXPECT_EQ(batchSizes, std::vector<std::size_t>({ 1 }));
+}
+
+TEST_F(EventBusTest, DispatchQueuedDeliversQueueAsOneBatch)
+{
+    std::vector<std::size_t> batchSizes;
+    subscriptions.push_back(eventBus.SubscribeBatch<TestEvent>(
+        [&batchSizes](std::span<const TestEvent> events) { batchSizes.push_back(events.size()); }));
+
+    for (int i = 0; i < 100; ++i)
+    {
+        eventBus.Enqueue<TestEvent>(i);
+    }
+    eventBus.DispatchQueued();
+
+    EXPECT_EQ(batchSizes, std::vector<std::size_t>({ 100 }));
+}
+
+// ============================================================================
+// Priority and Consumption Tests
+// ============================================================================
+
+TEST_F(EventBusTest, HigherPriorityHandlersRunFirst)
+{
+    std::vector<std::string> order;
+    auto record = [&order](std::string name) { return [&order, name](const TestEvent &) { order.push_back(name); }; };
+
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>(record("low"), -1));
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>(record("a")));
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>(record("high"), 10));
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>(record("b")));
+
+    eventBus.Publish(TestEvent(1));
+
+    EXPECT_EQ(order, std::vector<std::string>({ "high", "a", "b", "low" }));
+}
+
+TEST_F(EventBusTest, HandledEventStopsLowerPriorityHandlers)
+{
+    int lowCalls = 0;
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>([&lowCalls](const TestEvent &) { lowCalls++; }));
+    subscriptions.push_back(
+        eventBus.Subscribe<TestEvent>([](const TestEvent &event) { return event.value == 1; }, 100));
+
+    EXPECT_TRUE(eventBus.Publish(TestEvent(1)));
+    EXPECT_EQ(lowCalls, 0);
+
+    EXPECT_FALSE(eventBus.Publish(TestEvent(2)));
+    EXPECT_EQ(lowCalls, 1);
+}
+
+TEST_F(EventBusTest, PriorityOrderSurvivesUnsubscribe)
+{
+    std::vector<int> order;
+    auto makeHandler = [&order](int id) { return [&order, id](const TestEvent &) { order.push_back(id); }; };
+
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>(makeHandler(1), 3));
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>(makeHandler(2), 2));
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>(makeHandler(3), 1));
+
+    subscriptions[1].Reset();
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>(makeHandler(4), 2));
+    subscriptions[0].Reset();
+
+    eventBus.Publish(TestEvent(0));
+    EXPECT_EQ(order, std::vector<int>({ 4, 3 }));
+
+    // Dense indices of shifted handlers must still resolve to the right entry
+    subscriptions[3].Reset();
+    order.clear();
+    eventBus.Publish(TestEvent(0));
+    EXPECT_EQ(order, std::vector<int>({ 3 }));
+}
+
+TEST_F(EventBusTest, BatchStopsPropagationPerEvent)
+{
+    std::vector<int> observed;
+    subscriptions.push_back(
+        eventBus.Subscribe<TestEvent>([&observed](const TestEvent &event) { observed.push_back(event.value); }));
+    subscriptions.push_back(
+        eventBus.Subscribe<TestEvent>([](const TestEvent &event) { return event.value % 2 == 0; }, 1));
+
+    const std::vector<TestEvent> events = { TestEvent(1), TestEvent(2), TestEvent(3), TestEvent(4) };
+    eventBus.PublishBatch(std::span<const TestEvent>(events));
+
+    EXPECT_EQ(observed, std::vector<int>({ 1, 3 }));
+}
+
+// ============================================================================
+// Base-Type Subscription Tests
+// ============================================================================
+
+TEST_F(EventBusTest, BaseSubscriberReceivesDerivedEvents)
+{
+    int inputEvents = 0;
+    subscriptions.push_back(eventBus.Subscribe<InputEvent>([&inputEvents](const InputEvent &) { inputEvents++; }));
+
+    eventBus.Publish(InputEvent());
+    eventBus.Publish(KeyEvent(1));
+    eventBus.Publish(RepeatedKeyEvent(2));
+    eventBus.Publish(TestEvent(3));
+
+    EXPECT_EQ(inputEvents, 3);
+}
+
+TEST_F(EventBusTest, ExactSubscribersRunBeforeBaseSubscribers)
+{
+    std::vector<std::string> order;
+    subscriptions.push_back(eventBus.Subscribe<InputEvent>([&order](const InputEvent &) { order.push_back("input"); }));
+    subscriptions.push_back(eventBus.Subscribe<KeyEvent>([&order](const KeyEvent &) { order.push_back("key"); }));
+    subscriptions.push_back(
+        eventBus.Subscribe<RepeatedKeyEvent>([&order](const RepeatedKeyEvent &) { order.push_back("repeat"); }));
+
+    eventBus.Publish(RepeatedKeyEvent(1));
+
+    EXPECT_EQ(order, std::vector<std::string>({ "repeat", "key", "input" }));
+}
+
+TEST_F(EventBusTest, HandledEventDoesNotReachBaseSubscribers)
+{
+    int inputEvents = 0;
+    subscriptions.push_back(eventBus.Subscribe<InputEvent>([&inputEvents](const InputEvent &) { inputEvents++; }));
+    subscriptions.push_back(eventBus.Subscribe<KeyEvent>([](const KeyEvent &event) { return event.key == 1; }));
+
+    EXPECT_TRUE(eventBus.Publish(KeyEvent(1)));
+    EXPECT_FALSE(eventBus.Publish(KeyEvent(2)));
+
+    EXPECT_EQ(inputEvents, 1);
+}
+
+TEST_F(EventBusTest, BaseSubscriberReceivesBatchedAndQueuedDerivedEvents)
+{
+    std::vector<int> keys;
+    subscriptions.push_back(eventBus.Subscribe<InputEvent>([&keys](const InputEvent &event) {
+        keys.push_back(static_cast<const KeyEvent &>(event).key);
+    }));
+
+    const std::vector<KeyEvent> events = { KeyEvent(1), KeyEvent(2) };
+    eventBus.PublishBatch(std::span<const KeyEvent>(events));
+    eventBus.Enqueue<KeyEvent>(3);
+    eventBus.DispatchQueued();
+
+    EXPECT_EQ(keys, std::vector<int>({ 1, 2, 3 }));
+}
+
+// ============================================================================
+// Concurrent Handler Tests
+// ============================================================================
+
+TEST_F(EventBusTest, ConcurrentHandlersFanOutAndJoinBeforePublishReturns)
+{
+    ThreadPool pool(4);
+    eventBus.SetThreadPool(&pool);
+
+    constexpr int handlerCount = 8;
+    std::atomic<int> finished = 0;
+    std::mutex threadsMutex;
+    std::set<std::thread::id> threads;
+    for (int i = 0; i < handlerCount; ++i)
+    {
+        subscriptions.push_back(eventBus.SubscribeConcurrent<TestEvent>([&](const TestEvent &) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            {
+                std::lock_guard<std::mutex> lock(threadsMutex);
+                threads.insert(std::this_thread::get_id());
+            }
+            finished++;
+        }));
+    }
+
+    eventBus.Publish(TestEvent(1));
+
+    EXPECT_EQ(finished, handlerCount);
+    EXPECT_GT(threads.size(), 1u);
+    eventBus.SetThreadPool(nullptr);
+}
+
+TEST_F(EventBusTest, SequentialHandlersRunBeforeConcurrentOnes)
+{
+    ThreadPool pool(2);
+    eventBus.SetThreadPool(&pool);
+
+    std::atomic<bool> sequentialDone = false;
+    std::atomic<int> concurrentAfterSequential = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        subscriptions.push_back(eventBus.SubscribeConcurrent<TestEvent>([&](const TestEvent &) {
+            if (sequentialDone)
+            {
+                concurrentAfterSequential++;
+            }
+        }));
+    }
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>([&](const TestEvent &) { sequentialDone = true; }));
+
+    eventBus.Publish(TestEvent(1));
+
+    EXPECT_EQ(concurrentAfterSequential, 4);
+    eventBus.SetThreadPool(nullptr);
+}
+
+TEST_F(EventBusTest, HandledEventSkipsConcurrentHandlers)
+{
+    int concurrentCalls = 0;
+    subscriptions.push_back(eventBus.SubscribeConcurrent<TestEvent>([&](const TestEvent &) { concurrentCalls++; }));
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>([](const TestEvent &event) { return event.value == 1; }));
+
+    eventBus.Publish(TestEvent(1));
+    EXPECT_EQ(concurrentCalls, 0);
+
+    eventBus.Publish(TestEvent(2));
+    EXPECT_EQ(concurrentCalls, 1);
+}
+
+TEST_F(EventBusTest, UnsubscribingConcurrentHandlerKeepsOthers)
+{
+    std::vector<int> calls(3, 0);
+    for (int i = 0; i < 3; ++i)
+    {
+        subscriptions.push_back(
+            eventBus.SubscribeConcurrent<TestEvent>([&calls, i](const TestEvent &) { calls[i]++; }));
+    }
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>([](const TestEvent &) {}));
+
+    subscriptions[1].Reset();
+    eventBus.Publish(TestEvent(1));
+
+    EXPECT_EQ(calls, std::vector<int>({ 1, 0, 1 }));
+}
+
+// ============================================================================
+// Keyed Subscription Tests
+// ============================================================================
+
+TEST_F(EventBusTest, KeyedPublishReachesOnlyThatKeysHandlers)
+{
+    std::vector<int> first;
+    std::vector<int> second;
+    subscriptions.push_back(
+        eventBus.Subscribe<TestEvent>(1, [&first](const TestEvent &event) { first.push_back(event.value); }));
+    subscriptions.push_back(
+        eventBus.Subscribe<TestEvent>(2, [&second](const TestEvent &event) { second.push_back(event.value); }));
+
+    eventBus.Publish(1, TestEvent(10));
+    eventBus.Publish(2, TestEvent(20));
+    eventBus.Publish(3, TestEvent(30));
+    eventBus.Publish(TestEvent(40)); // Unkeyed publishes skip keyed handlers
+
+    EXPECT_EQ(first, std::vector<int>({ 10 }));
+    EXPECT_EQ(second, std::vector<int>({ 20 }));
+}
+
+TEST_F(EventBusTest, KeyedPublishAlsoReachesWildcardHandlersByPriority)
+{
+    std::vector<std::string> order;
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>([&order](const TestEvent &) { order.push_back("high"); }, 5));
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>([&order](const TestEvent &) { order.push_back("any"); }));
+    subscriptions.push_back(
+        eventBus.Subscribe<TestEvent>(7, [&order](const TestEvent &) { order.push_back("keyed"); }));
+    subscriptions.push_back(
+        eventBus.Subscribe<TestEvent>(7, [&order](const TestEvent &) { order.push_back("keyed-low"); }, -1));
+
+    eventBus.Publish(7, TestEvent(1));
+
+    EXPECT_EQ(order, std::vector<std::string>({ "high", "keyed", "any", "keyed-low" }));
+}
+
+TEST_F(EventBusTest, KeyedHandlerCanMarkEventHandled)
+{
+    int wildcardCalls = 0;
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>([&wildcardCalls](const TestEvent &) { wildcardCalls++; }));
+    subscriptions.push_back(
+        eventBus.Subscribe<TestEvent>(4, [](const TestEvent &event) { return event.value > 0; }, 1));
+
+    EXPECT_TRUE(eventBus.Publish(4, TestEvent(1)));
+    EXPECT_EQ(wildcardCalls, 0);
+
+    EXPECT_FALSE(eventBus.Publish(4, TestEvent(0)));
+    EXPECT_EQ(wildcardCalls, 1);
+}
+
+TEST_F(EventBusTest, ResettingKeyedTokenUnsubscribes)
+{
+    int calls = 0;
+    auto subscription = eventBus.Subscribe<TestEvent>(9, [&calls](const TestEvent &) { calls++; });
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>(9, [&calls](const TestEvent &) { calls += 10; }));
+
+    eventBus.Publish(9, TestEvent(1));
+    subscription.Reset();
+    eventBus.Publish(9, TestEvent(1));
+
+    EXPECT_EQ(calls, 21);
+}
+
+TEST_F(EventBusTest, KeyedHandlersSurviveTableGrowth)
+{
+    constexpr int keyCount = 1000;
+    std::vector<int> calls(keyCount, 0);
+    for (int key = 0; key < keyCount; ++key)
+    {
+        subscriptions.push_back(eventBus.Subscribe<TestEvent>(
+            static_cast<std::uint64_t>(key), [&calls, key](const TestEvent &) { calls[key]++; }));
+    }
+
+    // Unsubscribing every other key after growth exercises removal from rehashed buckets
+    for (int key = 0; key < keyCount; key += 2)
+    {
+        subscriptions[key].Reset();
+    }
+
+    for (int key = 0; key < keyCount; ++key)
+    {
+        eventBus.Publish(static_cast<std::uint64_t>(key), TestEvent(key));
+    }
+
+    for (int key = 0; key < keyCount; ++key)
+    {
+        EXPECT_EQ(calls[key], key % 2) << "key " << key;
+    }
+}
+
+TEST_F(EventBusTest, KeyedPublishWalksParentEvents)
+{
+    std::vector<std::string> order;
+    subscriptions.push_back(
+        eventBus.Subscribe<KeyEvent>(1, [&order](const KeyEvent &) { order.push_back("key-1"); }));
+    subscriptions.push_back(
+        eventBus.Subscribe<InputEvent>(1, [&order](const InputEvent &) { order.push_back("input-1"); }));
+    subscriptions.push_back(
+        eventBus.Subscribe<InputEvent>(2, [&order](const InputEvent &) { order.push_back("input-2"); }));
+
+    eventBus.Publish(1, KeyEvent(65));
+
+    EXPECT_EQ(order, std::vector<std::string>({ "key-1", "input-1" }));
+}
+
+TEST_F(EventBusTest, WildcardHandlersSeeThePublishKey)
+{
+    std::vector<std::optional<std::uint64_t>> keys;
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>([this, &keys](const TestEvent &event) {
+        keys.push_back(EventBus::GetPublishKey());
+        if (event.value == 1)
+        {
+            eventBus.Publish(EmptyEvent());
+            keys.push_back(EventBus::GetPublishKey());
+        }
+    }));
+    subscriptions.push_back(
+        eventBus.Subscribe<EmptyEvent>([&keys](const EmptyEvent &) { keys.push_back(EventBus::GetPublishKey()); }));
+
+    eventBus.Publish(5, TestEvent(1));
+    eventBus.Publish(TestEvent(2));
+
+    EXPECT_EQ(keys, (std::vector<std::optional<std::uint64_t>>{ 5, std::nullopt, 5, std::nullopt }));
+    EXPECT_FALSE(EventBus::GetPublishKey());
+}
+
+TEST_F(EventBusTest, ClearDropsKeyedHandlers)
+{
+    int calls = 0;
+    auto subscription = eventBus.Subscribe<TestEvent>(3, [&calls](const TestEvent &) { calls++; });
+
+    eventBus.Clear();
+    eventBus.Publish(3, TestEvent(1));
+    subscription.Reset();
+
+    EXPECT_EQ(calls, 0);
+}
+
+TEST_F(EventBusTest, LayerScopedKeyedSubscriptionEndsWithLayer)
+{
+    class EntityLayer : public Layer
+    {
+    public:
+        EntityLayer(EventBus &bus, int &calls)
+        {
+            bus.Subscribe<TestEvent>(*this, 5, [&calls](const TestEvent &) { calls++; });
+        }
+    };
+
+    int calls = 0;
+    auto layer = std::make_unique<EntityLayer>(eventBus, calls);
+
+    eventBus.Publish(5, TestEvent(1));
+    layer.reset();
+    eventBus.Publish(5, TestEvent(1));
+
+    EXPECT_EQ(calls, 1);
+}
+
+// ============================================================================
+// Concurrency Tests
+// ============================================================================
+
+TEST_F(EventBusTest, RemovedHandlersAreFreedByLaterWrites)
+{
+    auto state = std::make_shared<int>(0);
+    std::weak_ptr<int> watch = state;
+    auto subscription = eventBus.Subscribe<TestEvent>([state](const TestEvent &) { (*state)++; });
+    state.reset();
+
+    eventBus.Publish(TestEvent(1));
+    subscription.Reset();
+    EXPECT_FALSE(watch.expired()) << "Retired snapshots wait for the epoch to advance";
+
+    // With no publish in flight every write advances the epoch, so a couple of them free the snapshot
+    for (int i = 0; i < 3; ++i)
+    {
+        auto churn = eventBus.Subscribe<EmptyEvent>([](const EmptyEvent &) {});
+    }
+    EXPECT_TRUE(watch.expired());
+}
+
+TEST_F(EventBusTest, SnapshotOutlivesWritesDuringItsPublish)
+{
+    std::weak_ptr<int> watch;
+    std::vector<int> seen;
+    Subscription self;
+    {
+        auto state = std::make_shared<int>(7);
+        watch = state;
+        self = eventBus.Subscribe<TestEvent>([this, state, &self, &seen](const TestEvent &) {
+            self.Reset();
+            for (int i = 0; i < 8; ++i)
+            {
+                auto churn = eventBus.Subscribe<TestEvent>([](const TestEvent &) {});
+            }
+            // The publish that is running pins the snapshot holding this handler and its captures
+            seen.push_back(*state);
+        });
+    }
+    subscriptions.push_back(eventBus.Subscribe<TestEvent>([&seen](const TestEvent &) { seen.push_back(1); }, -1));
+
+    eventBus.Publish(TestEvent(0));
+    EXPECT_EQ(seen, (std::vector<int>{ 7, 1 }));
+
+    for (int i = 0; i < 3; ++i)
+    {
+        auto churn = eventBus.Subscribe<EmptyEvent>([](const EmptyEvent &) {});
+    }
+    EXPECT_TRUE(watch.expired());
+}
+
+TEST_F(EventBusTest, ConcurrentPublishWhileSubscribing)
+{
+    constexpr int publisherCount = 4;
+    constexpr int publishesPerThread = 2000;
+    constexpr int subscriberCount = 50;
+
+    std::atomic<int> firstHandlerCalls = 0;
+    subscriptions.push_back(
+        eventBus.Subscribe<TestEvent>([&firstHandlerCalls](const TestEvent &) { firstHandlerCalls++; }));
+
+    std::vector<std::thread> publishers;
+    for (int t = 0; t < publisherCount; ++t)
+    {
+        publishers.emplace_back([this] {
+            for (int i = 0; i < publishesPerThread; ++i)
+            {
+                eventBus.Publish(TestEvent(i));
+            }
+        });
+    }
+
+    std::atomic<int> lateHandlerCalls = 0;
+    for (int i = 0; i < subscriberCount; ++i)
+    {
+        subscriptions.push_back(
+            eventBus.Subscribe<TestEvent>([&lateHandlerCalls](const TestEvent &) { lateHandlerCalls++; }));
+    }
+
+    for (auto &publisher : publishers)
+    {
+        publisher.join();
+    }
+
+    // The first handler was present for every publish, late ones only for a subset
+    EXPECT_EQ(firstHandlerCalls, publisherCount * publishesPerThread);
+    EXPECT_LE(lateHandlerCalls, subscriberCount * publisherCount * publishesPerThread);
+}
+
+TEST_F(EventBusTest, ConcurrentPublishWhileUnsubscribing)
+{
+    constexpr int publisherCount = 4;
+    constexpr int churnCount = 500;
+
+    std::atomic<bool> stop = false;
+    std::atomic<int> publishes = 0;
+    std::vector<std::thread> publishers;
+    for (int t = 0; t < publisherCount; ++t)
+    {
+        publishers.emplace_back([this, &stop, &publishes] {
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                eventBus.Publish(TestEvent(1));
+                eventBus.Publish(7, TestEvent(2));
+                publishes++;
+            }
+        });
+    }
+
+    // Every replaced snapshot is retired and freed while publishers may still be walking older ones
+    for (int i = 0; i < churnCount; ++i)
+    {
+        auto state = std::make_shared<int>(i);
+        auto wildcard = eventBus.Subscribe<TestEvent>([state](const TestEvent &) { return *state < 0; });
+        auto keyed = eventBus.Subscribe<TestEvent>(7, [state](const TestEvent &) { return *state < 0; });
+    }
+
+    stop = true;
+    for (auto &publisher : publishers)
+    {
+        publisher.join();
+    }
+    EXPECT_GT(publishes.load(), 0);
+}
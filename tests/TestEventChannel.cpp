@@ -0,0 +1,186 @@
+#include "Kappa/EventBus.h"
+#include "Kappa/EventChannel.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace Kappa;
+
+// ============================================================================
+// Test Events
+// ============================================================================
+
+namespace
+{
+    class LoadedEvent : public Event
+    {
+    public:
+        explicit LoadedEvent(int val) : value(val)
+        {
+        }
+        int value;
+    };
+} // namespace
+
+// ============================================================================
+// EventChannel Tests
+// ============================================================================
+
+class EventChannelTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        subscription =
+            eventBus.Subscribe<LoadedEvent>([this](const LoadedEvent &event) { received.push_back(event.value); });
+    }
+
+    EventBus eventBus;
+    Subscription subscription;
+    std::vector<int> received;
+};
+
+TEST_F(EventChannelTest, CapacityRoundsUpToPowerOfTwo)
+{
+    EventChannel<LoadedEvent> channel({ .capacity = 5 });
+
+    EXPECT_EQ(channel.GetCapacity(), 8u);
+}
+
+TEST_F(EventChannelTest, DrainPublishesInPushOrder)
+{
+    EventChannel<LoadedEvent> channel;
+
+    EXPECT_TRUE(channel.Push(LoadedEvent(1)));
+    EXPECT_TRUE(channel.Push(LoadedEvent(2)));
+    EXPECT_TRUE(received.empty());
+
+    EXPECT_EQ(channel.Drain(eventBus), 2u);
+    EXPECT_EQ(received, std::vector<int>({ 1, 2 }));
+    EXPECT_EQ(channel.Drain(eventBus), 0u);
+}
+
+TEST_F(EventChannelTest, DropNewestRejectsPushWhenFull)
+{
+    EventChannel<LoadedEvent> channel({ .capacity = 2, .overflowPolicy = OverflowPolicy::DropNewest });
+
+    EXPECT_TRUE(channel.Push(LoadedEvent(1)));
+    EXPECT_TRUE(channel.Push(LoadedEvent(2)));
+    EXPECT_FALSE(channel.Push(LoadedEvent(3)));
+    EXPECT_EQ(channel.GetDroppedCount(), 1u);
+
+    channel.Drain(eventBus);
+    EXPECT_EQ(received, std::vector<int>({ 1, 2 }));
+}
+
+TEST_F(EventChannelTest, DropOldestKeepsNewestEvents)
+{
+    EventChannel<LoadedEvent> channel({ .capacity = 2, .overflowPolicy = OverflowPolicy::DropOldest });
+
+    for (int i = 1; i <= 5; ++i)
+    {
+        EXPECT_TRUE(channel.Push(LoadedEvent(i)));
+    }
+    EXPECT_EQ(channel.GetDroppedCount(), 3u);
+
+    channel.Drain(eventBus);
+    EXPECT_EQ(received, std::vector<int>({ 4, 5 }));
+}
+
+TEST_F(EventChannelTest, ThrowingHandlerReleasesItsCell)
+{
+    EventChannel<LoadedEvent> channel({ .capacity = 2, .overflowPolicy = OverflowPolicy::DropNewest });
+    auto thrower = eventBus.Subscribe<LoadedEvent>([](const LoadedEvent &event) {
+        if (event.value == 1)
+        {
+            throw std::runtime_error("handler failed");
+        }
+    });
+
+    EXPECT_TRUE(channel.Push(LoadedEvent(1)));
+    EXPECT_TRUE(channel.Push(LoadedEvent(2)));
+    EXPECT_THROW(channel.Drain(eventBus), std::runtime_error);
+
+    // The failed event's cell is free again, so the ring still accepts and delivers events
+    EXPECT_TRUE(channel.Push(LoadedEvent(3)));
+    EXPECT_EQ(channel.Drain(eventBus), 2u);
+    EXPECT_EQ(received, std::vector<int>({ 1, 2, 3 }));
+    EXPECT_EQ(channel.GetDroppedCount(), 0u);
+}
+
+TEST_F(EventChannelTest, BlockWaitsForConsumer)
+{
+    EventChannel<LoadedEvent> channel({ .capacity = 2, .overflowPolicy = OverflowPolicy::Block });
+    constexpr int eventCount = 100;
+
+    std::thread producer([&channel] {
+        for (int i = 0; i < eventCount; ++i)
+        {
+            channel.Push(LoadedEvent(i));
+        }
+    });
+
+    while (received.size() < eventCount)
+    {
+        channel.Drain(eventBus);
+        std::this_thread::yield();
+    }
+    producer.join();
+
+    EXPECT_EQ(channel.GetDroppedCount(), 0u);
+    for (int i = 0; i < eventCount; ++i)
+    {
+        EXPECT_EQ(received[i], i);
+    }
+}
+
+TEST_F(EventChannelTest, ManyProducersDeliverEveryEventOnConsumerThread)
+{
+    EventChannel<LoadedEvent> channel({ .capacity = 64, .overflowPolicy = OverflowPolicy::Block });
+    constexpr int producerCount = 4;
+    constexpr int eventsPerProducer = 1000;
+
+    const auto consumerThread = std::this_thread::get_id();
+    std::atomic<bool> deliveredOnConsumer = true;
+    auto threadCheck = eventBus.Subscribe<LoadedEvent>([&](const LoadedEvent &) {
+        if (std::this_thread::get_id() != consumerThread)
+        {
+            deliveredOnConsumer = false;
+        }
+    });
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producerCount; ++p)
+    {
+        producers.emplace_back([&channel, p] {
+            for (int i = 0; i < eventsPerProducer; ++i)
+            {
+                channel.Push(LoadedEvent(p * eventsPerProducer + i));
+            }
+        });
+    }
+
+    while (received.size() < producerCount * eventsPerProducer)
+    {
+        channel.Drain(eventBus);
+        std::this_thread::yield();
+    }
+
+    for (auto &producer : producers)
+    {
+        producer.join();
+    }
+
+    EXPECT_TRUE(deliveredOnConsumer);
+    std::vector<bool> seen(producerCount * eventsPerProducer, false);
+    for (const int value : received)
+    {
+        seen[value] = true;
+    }
+    EXPECT_EQ(std::count(seen.begin(), seen.end(), false), 0);
+}
@@ -0,0 +1,364 @@
+#include "Kappa/EventBus.h"
+#include "Kappa/EventRecording.h"
+#include "Kappa/Layer.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Kappa;
+
+namespace
+{
+    class CursorEvent : public Event
+    {
+    public:
+        CursorEvent() = default;
+        CursorEvent(float x, float y) : x(x), y(y)
+        {
+        }
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    class TextEvent : public Event
+    {
+    public:
+        explicit TextEvent(std::string text = {}) : text(std::move(text))
+        {
+        }
+        std::string text;
+    };
+
+    class IgnoredEvent : public Event
+    {
+    };
+} // namespace
+
+template<> struct Kappa::EventSerializer<CursorEvent>
+{
+    static void Write(BinaryWriter &writer, const CursorEvent &event)
+    {
+        writer.Write(event.x);
+        writer.Write(event.y);
+    }
+
+    static CursorEvent Read(BinaryReader &reader)
+    {
+        const auto x = reader.Read<float>();
+        const auto y = reader.Read<float>();
+        return CursorEvent(x, y);
+    }
+};
+
+template<> struct Kappa::EventSerializer<TextEvent>
+{
+    static void Write(BinaryWriter &writer, const TextEvent &event)
+    {
+        writer.WriteString(event.text);
+    }
+
+    static TextEvent Read(BinaryReader &reader)
+    {
+        return TextEvent(reader.ReadString());
+    }
+};
+
+template<> struct Kappa::EventSerializer<IgnoredEvent>
+{
+    static void Write(BinaryWriter &, const IgnoredEvent &)
+    {
+    }
+
+    static IgnoredEvent Read(BinaryReader &)
+    {
+        return IgnoredEvent();
+    }
+};
+
+// ============================================================================
+// BinaryWriter / BinaryReader Tests
+// ============================================================================
+
+TEST(BinaryStreamTest, RoundTripsValuesVarintsAndStrings)
+{
+    BinaryWriter writer;
+    writer.Write(std::int32_t{ -7 });
+    writer.WriteVarint(0);
+    writer.WriteVarint(127);
+    writer.WriteVarint(128);
+    writer.WriteVarint(~std::uint64_t{ 0 });
+    writer.WriteString("hitch");
+
+    BinaryReader reader(writer.GetData());
+    EXPECT_EQ(reader.Read<std::int32_t>(), -7);
+    EXPECT_EQ(reader.ReadVarint(), 0u);
+    EXPECT_EQ(reader.ReadVarint(), 127u);
+    EXPECT_EQ(reader.ReadVarint(), 128u);
+    EXPECT_EQ(reader.ReadVarint(), ~std::uint64_t{ 0 });
+    EXPECT_EQ(reader.ReadString(), "hitch");
+    EXPECT_EQ(reader.GetRemaining(), 0u);
+    EXPECT_TRUE(reader.IsValid());
+}
+
+TEST(BinaryStreamTest, SmallVarintsTakeOneByte)
+{
+    BinaryWriter writer;
+    writer.WriteVarint(5);
+    EXPECT_EQ(writer.GetData().size(), 1u);
+}
+
+TEST(BinaryStreamTest, ReadingPastEndInvalidatesReader)
+{
+    BinaryWriter writer;
+    writer.Write(std::uint16_t{ 1 });
+
+    BinaryReader reader(writer.GetData());
+    EXPECT_EQ(reader.Read<std::uint64_t>(), 0u);
+    EXPECT_FALSE(reader.IsValid());
+    EXPECT_TRUE(reader.ReadString().empty());
+}
+
+// ============================================================================
+// Recording and Replay Tests
+// ============================================================================
+
+class EventRecordingTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        const auto *test = ::testing::UnitTest::GetInstance()->current_test_info();
+        path = (std::filesystem::temp_directory_path() / (std::string("kappa_") + test->name() + ".kevr")).string();
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(path);
+    }
+
+    std::string path;
+};
+
+TEST_F(EventRecordingTest, ReplayReproducesEventsPerFrame)
+{
+    {
+        EventBus bus;
+        EventRecorder recorder(bus);
+        recorder.Record<CursorEvent>();
+        ASSERT_TRUE(recorder.Open(path));
+        recorder.Record<TextEvent>();
+
+        bus.Publish(CursorEvent(1.0f, 2.0f));
+        recorder.EndFrame();
+        recorder.EndFrame();
+        bus.Publish(TextEvent("a"));
+        bus.Publish(CursorEvent(3.0f, 4.0f));
+        recorder.EndFrame();
+        recorder.EndFrame();
+
+        EXPECT_EQ(recorder.GetEventCount(), 3u);
+        EXPECT_EQ(recorder.GetFrameIndex(), 4u);
+    }
+
+    EventReplayer replayer;
+    ASSERT_TRUE(replayer.Open(path));
+    replayer.Register<CursorEvent>();
+    replayer.Register<TextEvent>();
+    EXPECT_EQ(replayer.GetFrameCount(), 4u);
+    EXPECT_EQ(replayer.GetEventCount(), 3u);
+
+    EventBus bus;
+    std::vector<std::string> received;
+    auto cursor = bus.Subscribe<CursorEvent>([&received](const CursorEvent &event) {
+        received.push_back("cursor " + std::to_string(static_cast<int>(event.x + event.y)));
+    });
+    auto text = bus.Subscribe<TextEvent>([&received](const TextEvent &event) { received.push_back(event.text); });
+
+    std::vector<std::size_t> perFrame;
+    while (replayer.PublishFrame(bus))
+    {
+        perFrame.push_back(received.size());
+    }
+
+    EXPECT_EQ(received, (std::vector<std::string>{ "cursor 3", "a", "cursor 7" }));
+    EXPECT_EQ(perFrame, (std::vector<std::size_t>{ 1, 1, 3, 3 }));
+}
+
+TEST_F(EventRecordingTest, RecorderSeesEventsBeforeTheyAreHandled)
+{
+    {
+        EventBus bus;
+        auto consumer = bus.Subscribe<CursorEvent>([](const CursorEvent &) { return true; }, 1000);
+        EventRecorder recorder(bus);
+        recorder.Record<CursorEvent>();
+        ASSERT_TRUE(recorder.Open(path));
+
+        bus.Publish(CursorEvent());
+        EXPECT_EQ(recorder.GetEventCount(), 1u);
+    }
+}
+
+TEST_F(EventRecordingTest, KeyedEventsReplayUnderTheirKey)
+{
+    {
+        EventBus bus;
+        EventRecorder recorder(bus);
+        recorder.Record<CursorEvent>();
+        recorder.Record<TextEvent>();
+        ASSERT_TRUE(recorder.Open(path));
+
+        // An unkeyed event published from a keyed handler must not inherit the outer key
+        auto relay = bus.Subscribe<CursorEvent>(7, [&bus](const CursorEvent &) { bus.Publish(TextEvent("relay")); });
+
+        bus.Publish(7, CursorEvent(1.0f, 0.0f));
+        bus.Publish(CursorEvent(2.0f, 0.0f));
+        bus.Coalesce(9, CursorEvent(3.0f, 0.0f));
+        bus.DispatchQueued();
+        recorder.EndFrame();
+
+        EXPECT_EQ(recorder.GetEventCount(), 4u);
+    }
+
+    EventReplayer replayer;
+    ASSERT_TRUE(replayer.Open(path));
+    replayer.Register<CursorEvent>();
+    replayer.Register<TextEvent>();
+
+    EventBus bus;
+    std::vector<float> seven;
+    std::vector<float> nine;
+    std::vector<float> all;
+    int texts = 0;
+    auto sevenSubscription = bus.Subscribe<CursorEvent>(7, [&seven](const CursorEvent &event) {
+        seven.push_back(event.x);
+    });
+    auto nineSubscription = bus.Subscribe<CursorEvent>(9, [&nine](const CursorEvent &event) {
+        nine.push_back(event.x);
+    });
+    auto allSubscription = bus.Subscribe<CursorEvent>([&all](const CursorEvent &event) { all.push_back(event.x); });
+    auto textSubscription = bus.Subscribe<TextEvent>([&texts](const TextEvent &event) {
+        EXPECT_EQ(event.text, "relay");
+        EXPECT_FALSE(EventBus::GetPublishKey());
+        texts++;
+    });
+
+    EXPECT_TRUE(replayer.PublishFrame(bus));
+    EXPECT_EQ(seven, (std::vector<float>{ 1.0f }));
+    EXPECT_EQ(nine, (std::vector<float>{ 3.0f }));
+    EXPECT_EQ(all, (std::vector<float>{ 1.0f, 2.0f, 3.0f }));
+    EXPECT_EQ(texts, 1);
+}
+
+TEST_F(EventRecordingTest, UnregisteredTypesAreSkipped)
+{
+    {
+        EventBus bus;
+        EventRecorder recorder(bus);
+        recorder.Record<IgnoredEvent>();
+        recorder.Record<CursorEvent>();
+        ASSERT_TRUE(recorder.Open(path));
+
+        bus.Publish(IgnoredEvent());
+        bus.Publish(CursorEvent(5.0f, 0.0f));
+        recorder.EndFrame();
+    }
+
+    EventReplayer replayer;
+    ASSERT_TRUE(replayer.Open(path));
+    replayer.Register<CursorEvent>();
+
+    EventBus bus;
+    int cursorEvents = 0;
+    auto subscription = bus.Subscribe<CursorEvent>([&cursorEvents](const CursorEvent &) { cursorEvents++; });
+
+    EXPECT_TRUE(replayer.PublishFrame(bus));
+    EXPECT_FALSE(replayer.PublishFrame(bus));
+    EXPECT_EQ(cursorEvents, 1);
+}
+
+TEST_F(EventRecordingTest, TruncatedRecordingReplaysCompleteRecords)
+{
+    {
+        EventBus bus;
+        EventRecorder recorder(bus);
+        recorder.Record<CursorEvent>();
+        ASSERT_TRUE(recorder.Open(path));
+        bus.Publish(CursorEvent());
+        recorder.EndFrame();
+        bus.Publish(CursorEvent());
+        recorder.EndFrame();
+    }
+
+    // Cut off the end record and half of the last event, as if the process died mid-write
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+
+    EventReplayer replayer;
+    ASSERT_TRUE(replayer.Open(path));
+    EXPECT_EQ(replayer.GetEventCount(), 1u);
+    EXPECT_EQ(replayer.GetFrameCount(), 1u);
+}
+
+TEST_F(EventRecordingTest, OpenRejectsOtherFiles)
+{
+    std::ofstream(path, std::ios::binary) << "not a recording";
+
+    EventReplayer replayer;
+    EXPECT_FALSE(replayer.Open(path));
+    EXPECT_FALSE(replayer.Open(path + ".missing"));
+}
+
+TEST_F(EventRecordingTest, RunUpdatesLayersWithFixedTimestep)
+{
+    {
+        EventBus bus;
+        EventRecorder recorder(bus);
+        recorder.Record<CursorEvent>();
+        ASSERT_TRUE(recorder.Open(path));
+        for (int frame = 0; frame < 3; ++frame)
+        {
+            bus.Publish(CursorEvent(static_cast<float>(frame), 0.0f));
+            recorder.EndFrame();
+        }
+    }
+
+    class TrackingLayer : public Layer
+    {
+    public:
+        explicit TrackingLayer(EventBus &bus)
+        {
+            bus.Subscribe<CursorEvent>(*this, [this](const CursorEvent &event) { lastX = event.x; });
+        }
+
+        void OnUpdate(float deltaTime) override
+        {
+            updates.push_back(lastX);
+            totalTime += deltaTime;
+        }
+
+        std::vector<float> updates;
+        float lastX = -1.0f;
+        float totalTime = 0.0f;
+    };
+
+    EventBus bus;
+    std::vector<std::unique_ptr<Layer>> layers;
+    layers.push_back(std::make_unique<TrackingLayer>(bus));
+    auto &layer = static_cast<TrackingLayer &>(*layers.front());
+
+    EventReplayer replayer;
+    ASSERT_TRUE(replayer.Open(path));
+    replayer.Register<CursorEvent>();
+
+    EXPECT_EQ(replayer.Run(bus, layers, 0.5f), 3u);
+    EXPECT_EQ(layer.updates, (std::vector<float>{ 0.0f, 1.0f, 2.0f }));
+    EXPECT_FLOAT_EQ(layer.totalTime, 1.5f);
+
+    replayer.Rewind();
+    EXPECT_EQ(replayer.GetFrameIndex(), 0u);
+}
@@ -0,0 +1,194 @@
+#include "Kappa/EventBus.h"
+#include "Kappa/EventStats.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Kappa;
+
+namespace
+{
+    class SampledEvent : public Event
+    {
+    };
+
+    class UnobservedEvent : public Event
+    {
+    };
+
+    const EventTypeStats *FindType(const EventBusStats &stats, const std::string &fragment)
+    {
+        for (const auto &type : stats.eventTypes)
+        {
+            if (type.name.find(fragment) != std::string::npos)
+            {
+                return &type;
+            }
+        }
+        return nullptr;
+    }
+} // namespace
+
+// ============================================================================
+// LatencyHistogram Tests
+// ============================================================================
+
+TEST(LatencyHistogramTest, SmallValuesAreExact)
+{
+    for (std::uint64_t value = 0; value < 32; ++value)
+    {
+        EXPECT_EQ(LatencyHistogram::BucketUpperBound(LatencyHistogram::BucketIndex(value)), value);
+    }
+}
+
+TEST(LatencyHistogramTest, BucketsBoundRelativeError)
+{
+    for (std::uint64_t value = 32; value < (std::uint64_t{ 1 } << 36); value = value * 3 / 2 + 7)
+    {
+        const auto index = LatencyHistogram::BucketIndex(value);
+        ASSERT_LT(index, LatencyHistogram::BucketCount);
+
+        const auto upper = LatencyHistogram::BucketUpperBound(index);
+        EXPECT_GE(upper, value);
+        EXPECT_LE(upper - value, value / LatencyHistogram::SubBucketCount);
+        EXPECT_EQ(LatencyHistogram::BucketIndex(upper), index);
+        EXPECT_EQ(LatencyHistogram::BucketIndex(upper + 1), index + 1);
+    }
+}
+
+TEST(LatencyHistogramTest, HugeValuesClampToLastBucket)
+{
+    EXPECT_EQ(LatencyHistogram::BucketIndex(~std::uint64_t{ 0 }), LatencyHistogram::BucketCount - 1);
+}
+
+TEST(LatencyHistogramTest, PercentilesFollowDistribution)
+{
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.GetValueAtPercentile(50.0), 0u);
+
+    for (int i = 0; i < 90; ++i)
+    {
+        histogram.Record(10);
+    }
+    for (int i = 0; i < 10; ++i)
+    {
+        histogram.Record(100000);
+    }
+
+    EXPECT_EQ(histogram.GetCount(), 100u);
+    EXPECT_EQ(histogram.GetValueAtPercentile(50.0), 10u);
+    EXPECT_EQ(histogram.GetValueAtPercentile(90.0), 10u);
+    EXPECT_GE(histogram.GetValueAtPercentile(99.0), 100000u);
+    EXPECT_LE(histogram.GetValueAtPercentile(99.0), 100000u + 100000u / LatencyHistogram::SubBucketCount);
+}
+
+// ============================================================================
+// EventBus Instrumentation Tests
+// ============================================================================
+
+TEST(EventStatsTest, DisabledBuildReportsNothing)
+{
+    if constexpr (EventBus::IsInstrumented)
+    {
+        GTEST_SKIP() << "Built with KAPPA_ENABLE_EVENT_STATS";
+    }
+
+    EventBus bus;
+    auto subscription = bus.Subscribe<SampledEvent>([](const SampledEvent &) {});
+    bus.Publish(SampledEvent());
+    bus.EndStatsFrame();
+
+    const auto stats = bus.GetStats();
+    EXPECT_EQ(stats.frameCount, 0u);
+    EXPECT_TRUE(stats.eventTypes.empty());
+}
+
+TEST(EventStatsTest, CountsPublishesPerFrame)
+{
+    if constexpr (!EventBus::IsInstrumented)
+    {
+        GTEST_SKIP() << "Requires KAPPA_ENABLE_EVENT_STATS";
+    }
+
+    EventBus bus;
+    auto subscription = bus.Subscribe<SampledEvent>([](const SampledEvent &) {});
+
+    for (int i = 0; i < 3; ++i)
+    {
+        bus.Publish(SampledEvent());
+    }
+    bus.EndStatsFrame();
+    bus.Publish(SampledEvent());
+    bus.Publish(UnobservedEvent());
+    bus.EndStatsFrame();
+
+    const auto stats = bus.GetStats();
+    EXPECT_EQ(stats.frameCount, 2u);
+
+    const auto *sampled = FindType(stats, "SampledEvent");
+    ASSERT_NE(sampled, nullptr);
+    EXPECT_EQ(sampled->publishCount, 4u);
+    EXPECT_EQ(sampled->publishesLastFrame, 1u);
+    EXPECT_EQ(sampled->maxPublishesPerFrame, 3u);
+    EXPECT_EQ(sampled->subscriberCount, 1u);
+
+    const auto *unobserved = FindType(stats, "UnobservedEvent");
+    ASSERT_NE(unobserved, nullptr);
+    EXPECT_EQ(unobserved->publishCount, 1u);
+    EXPECT_EQ(unobserved->subscriberCount, 0u);
+}
+
+TEST(EventStatsTest, TimesEveryHandler)
+{
+    if constexpr (!EventBus::IsInstrumented)
+    {
+        GTEST_SKIP() << "Requires KAPPA_ENABLE_EVENT_STATS";
+    }
+
+    EventBus bus;
+    auto fast = bus.Subscribe<SampledEvent>([](const SampledEvent &) {});
+    auto slow = bus.Subscribe<SampledEvent>(
+        [](const SampledEvent &) { std::this_thread::sleep_for(std::chrono::milliseconds(2)); }, -1);
+
+    bus.Publish(SampledEvent());
+    bus.Publish(SampledEvent());
+
+    const auto stats = bus.GetStats();
+    const auto *sampled = FindType(stats, "SampledEvent");
+    ASSERT_NE(sampled, nullptr);
+    ASSERT_EQ(sampled->handlers.size(), 2u);
+
+    const auto &slowHandler = sampled->handlers[1];
+    EXPECT_EQ(slowHandler.priority, -1);
+    EXPECT_EQ(slowHandler.callCount, 2u);
+    EXPECT_EQ(slowHandler.latency.GetCount(), 2u);
+    EXPECT_GE(slowHandler.maxNanoseconds, 2'000'000u);
+    EXPECT_GE(sampled->maxHandlerNanoseconds, slowHandler.maxNanoseconds);
+    EXPECT_GE(sampled->totalHandlerNanoseconds, slowHandler.totalNanoseconds + sampled->handlers[0].totalNanoseconds);
+
+    bus.ResetStats();
+    const auto reset = bus.GetStats();
+    EXPECT_EQ(FindType(reset, "SampledEvent")->handlers[1].callCount, 0u);
+}
+
+TEST(EventStatsTest, ToJsonIncludesTypesAndHandlers)
+{
+    if constexpr (!EventBus::IsInstrumented)
+    {
+        GTEST_SKIP() << "Requires KAPPA_ENABLE_EVENT_STATS";
+    }
+
+    EventBus bus;
+    auto subscription = bus.Subscribe<SampledEvent>([](const SampledEvent &) {});
+    bus.Publish(SampledEvent());
+
+    const auto json = bus.GetStats().ToJson(-1);
+    EXPECT_NE(json.find("SampledEvent\""), std::string::npos);
+    EXPECT_NE(json.find("\"p99Nanoseconds\""), std::string::npos);
+    EXPECT_NE(json.find("\"histogram\":[["), std::string::npos);
+}
@@ -0,0 +1,93 @@
+#include "Kappa/EventStream.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using namespace Kappa;
+
+namespace
+{
+    struct Contact
+    {
+        int first = 0;
+        int second = 0;
+    };
+} // namespace
+
+// ============================================================================
+// EventStream Tests
+// ============================================================================
+
+TEST(EventStreamTest, EventsBecomeReadableAfterSwap)
+{
+    EventStream<Contact> stream;
+    stream.Push({ 1, 2 });
+    stream.Emplace(3, 4);
+
+    EXPECT_TRUE(stream.Read().empty());
+    EXPECT_EQ(stream.GetPendingCount(), 2u);
+
+    stream.Swap();
+
+    ASSERT_EQ(stream.Read().size(), 2u);
+    EXPECT_EQ(stream.Read()[0].first, 1);
+    EXPECT_EQ(stream.Read()[1].second, 4);
+    EXPECT_EQ(stream.GetPendingCount(), 0u);
+}
+
+TEST(EventStreamTest, EventsAreReadableForExactlyOneFrame)
+{
+    EventStream<int> stream;
+    stream.Push(1);
+    stream.Swap();
+    stream.Push(2);
+    stream.Push(3);
+
+    // Writes of the current frame don't disturb what readers see
+    EXPECT_EQ(std::vector<int>(stream.Read().begin(), stream.Read().end()), (std::vector<int>{ 1 }));
+
+    stream.Swap();
+    EXPECT_EQ(std::vector<int>(stream.Read().begin(), stream.Read().end()), (std::vector<int>{ 2, 3 }));
+
+    stream.Swap();
+    EXPECT_TRUE(stream.Read().empty());
+}
+
+TEST(EventStreamTest, SteadyStateReusesBuffers)
+{
+    EventStream<std::string> stream;
+    const auto writeFrame = [&stream] {
+        for (int i = 0; i < 64; ++i)
+        {
+            stream.Emplace("event");
+        }
+        stream.Swap();
+    };
+
+    // Two warm-up frames size both buffers
+    writeFrame();
+    const auto *first = stream.Read().data();
+    writeFrame();
+    const auto *second = stream.Read().data();
+
+    // From then on the buffers alternate without reallocating
+    writeFrame();
+    EXPECT_EQ(stream.Read().data(), first);
+    writeFrame();
+    EXPECT_EQ(stream.Read().data(), second);
+}
+
+TEST(EventStreamTest, ClearDropsBothBuffers)
+{
+    EventStream<int> stream;
+    stream.Push(1);
+    stream.Swap();
+    stream.Push(2);
+
+    stream.Clear();
+
+    EXPECT_TRUE(stream.Read().empty());
+    EXPECT_EQ(stream.GetPendingCount(), 0u);
+}
@@ -0,0 +1,72 @@
+#include "Kappa/FixedTimestep.h"
+
+#include <gtest/gtest.h>
+
+using namespace Kappa;
+
+// ============================================================================
+// FixedTimestep Tests
+// ============================================================================
+
+TEST(FixedTimestepTest, FastFramesAccumulateIntoSteps)
+{
+    FixedTimestep timestep(1.0f / 60.0f);
+
+    // A 240 Hz display steps a 60 Hz simulation every fourth frame
+    int steps = 0;
+    for (int frame = 0; frame < 240; ++frame)
+    {
+        steps += timestep.Advance(1.0f / 240.0f);
+    }
+
+    EXPECT_NEAR(steps, 60, 1);
+    EXPECT_EQ(timestep.GetStepCount(), static_cast<std::uint64_t>(steps));
+    EXPECT_EQ(timestep.GetDroppedSteps(), 0u);
+}
+
+TEST(FixedTimestepTest, SlowFramesRunSeveralSteps)
+{
+    FixedTimestep timestep(0.01f);
+
+    EXPECT_EQ(timestep.Advance(0.035f), 3);
+    EXPECT_NEAR(timestep.GetAlpha(), 0.5f, 1e-3f);
+
+    EXPECT_EQ(timestep.Advance(0.005f), 1);
+    EXPECT_NEAR(timestep.GetAlpha(), 0.0f, 1e-3f);
+}
+
+TEST(FixedTimestepTest, CatchUpIsCapped)
+{
+    FixedTimestep timestep(0.01f, 4);
+
+    EXPECT_EQ(timestep.Advance(0.1025f), 4);
+    EXPECT_EQ(timestep.GetDroppedSteps(), 6u);
+    EXPECT_NEAR(timestep.GetAlpha(), 0.25f, 1e-2f);
+
+    // The backlog was dropped, so the next normal frame is back to a single step
+    EXPECT_EQ(timestep.Advance(0.01f), 1);
+}
+
+TEST(FixedTimestepTest, AlphaStaysBelowOne)
+{
+    FixedTimestep timestep(1.0f / 60.0f);
+
+    for (int frame = 0; frame < 1000; ++frame)
+    {
+        timestep.Advance(0.007f);
+        EXPECT_GE(timestep.GetAlpha(), 0.0f);
+        EXPECT_LT(timestep.GetAlpha(), 1.0f);
+    }
+}
+
+TEST(FixedTimestepTest, ResetClearsAccumulatedTime)
+{
+    FixedTimestep timestep(0.01f);
+    timestep.Advance(0.025f);
+
+    timestep.Reset();
+
+    EXPECT_EQ(timestep.GetAlpha(), 0.0f);
+    EXPECT_EQ(timestep.GetStepCount(), 0u);
+    EXPECT_EQ(timestep.Advance(0.005f), 0);
+}
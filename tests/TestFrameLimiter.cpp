@@ -0,0 +1,123 @@
+#include "Kappa/FrameLimiter.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+using namespace Kappa;
+using namespace std::chrono_literals;
+
+// ============================================================================
+// FrameLimiter Tests
+// ============================================================================
+
+TEST(FrameLimiterTest, UnlimitedOnlyMeasures)
+{
+    FrameLimiter limiter;
+
+    const auto start = FrameLimiter::Clock::now();
+    for (int frame = 0; frame < 10; ++frame)
+    {
+        limiter.EndFrame();
+    }
+    const auto elapsed = FrameLimiter::Clock::now() - start;
+
+    const auto stats = limiter.GetStats();
+    EXPECT_LT(elapsed, 5ms);
+    EXPECT_EQ(stats.targetFrameNanoseconds, 0u);
+    EXPECT_EQ(stats.frameCount, 10u);
+    EXPECT_EQ(stats.missedFrames, 0u);
+}
+
+TEST(FrameLimiterTest, CapsFrameRate)
+{
+    FrameLimiter limiter(200.0);
+    limiter.EndFrame(); // Aligns the schedule with the loop
+
+    const auto start = FrameLimiter::Clock::now();
+    for (int frame = 0; frame < 20; ++frame)
+    {
+        limiter.EndFrame();
+    }
+    const auto elapsed = FrameLimiter::Clock::now() - start;
+
+    // Deadlines advance by exactly one period, so 20 frames never finish early
+    EXPECT_GE(elapsed, 20 * 5ms - 1ms);
+
+    const auto stats = limiter.GetStats();
+    EXPECT_EQ(stats.targetFrameNanoseconds, 5'000'000u);
+    EXPECT_GE(stats.averageFrameNanoseconds, 4'500'000.0);
+}
+
+TEST(FrameLimiterTest, MissedDeadlineRestartsSchedule)
+{
+    FrameLimiter limiter(1000.0);
+    limiter.EndFrame();
+
+    std::this_thread::sleep_for(5ms);
+    limiter.EndFrame();
+    EXPECT_EQ(limiter.GetStats().missedFrames, 1u);
+
+    // The next frame gets a full period instead of being rushed to make up for the late one
+    const auto start = FrameLimiter::Clock::now();
+    limiter.EndFrame();
+    EXPECT_GE(FrameLimiter::Clock::now() - start, 900us);
+}
+
+TEST(FrameLimiterTest, StatsReportJitter)
+{
+    FrameLimiter limiter;
+    limiter.EndFrame();
+
+    for (int frame = 0; frame < 10; ++frame)
+    {
+        std::this_thread::sleep_for(frame % 2 == 0 ? 1ms : 4ms);
+        limiter.EndFrame();
+    }
+
+    const auto stats = limiter.GetStats();
+    EXPECT_EQ(stats.sampleCount, 11u);
+    EXPECT_LT(stats.minFrameNanoseconds, stats.maxFrameNanoseconds);
+    EXPECT_GT(stats.jitterNanoseconds, 500'000.0);
+}
+
+TEST(FrameLimiterTest, StatsCoverRecentWindow)
+{
+    FrameLimiter limiter;
+    for (std::size_t frame = 0; frame < FrameLimiter::WindowSize + 30; ++frame)
+    {
+        limiter.EndFrame();
+    }
+
+    const auto stats = limiter.GetStats();
+    EXPECT_EQ(stats.sampleCount, FrameLimiter::WindowSize);
+    EXPECT_EQ(stats.frameCount, FrameLimiter::WindowSize + 30);
+}
+
+TEST(FrameLimiterTest, SetTargetFrameRateRemovesCap)
+{
+    FrameLimiter limiter(10.0);
+    limiter.SetTargetFrameRate(0.0);
+
+    const auto start = FrameLimiter::Clock::now();
+    limiter.EndFrame();
+    limiter.EndFrame();
+
+    EXPECT_LT(FrameLimiter::Clock::now() - start, 50ms);
+    EXPECT_EQ(limiter.GetTargetFrameRate(), 0.0);
+}
+
+TEST(FrameLimiterTest, RestartIgnoresIdleGap)
+{
+    FrameLimiter limiter(1000.0);
+    limiter.EndFrame();
+
+    std::this_thread::sleep_for(20ms);
+    limiter.Restart();
+    limiter.EndFrame();
+
+    const auto stats = limiter.GetStats();
+    EXPECT_EQ(stats.missedFrames, 0u);
+    EXPECT_LT(stats.maxFrameNanoseconds, 10'000'000u);
+}
@@ -0,0 +1,142 @@
+#include "Kappa/InplaceFunction.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+#include <utility>
+
+using namespace Kappa;
+
+namespace
+{
+    /**
+     * @brief Counts live instances so tests can check destruction.
+     */
+    struct Tracked
+    {
+        explicit Tracked(int *live) : live(live)
+        {
+            ++*live;
+        }
+
+        Tracked(const Tracked &other) : live(other.live)
+        {
+            ++*live;
+        }
+
+        Tracked(Tracked &&other) noexcept : live(other.live)
+        {
+            ++*live;
+        }
+
+        ~Tracked()
+        {
+            --*live;
+        }
+
+        int operator()(int value) const
+        {
+            return value * 2;
+        }
+
+        int *live;
+    };
+} // namespace
+
+// ============================================================================
+// InplaceFunction Tests
+// ============================================================================
+
+TEST(InplaceFunctionTest, DefaultIsEmpty)
+{
+    InplaceFunction<void()> function;
+    EXPECT_FALSE(function);
+
+    InplaceFunction<void()> null = nullptr;
+    EXPECT_FALSE(null);
+}
+
+TEST(InplaceFunctionTest, InvokesCallableAndReturnsResult)
+{
+    int offset = 10;
+    InplaceFunction<int(int)> function = [&offset](int value) { return value + offset; };
+
+    ASSERT_TRUE(function);
+    EXPECT_EQ(function(5), 15);
+}
+
+TEST(InplaceFunctionTest, MutableCallableKeepsState)
+{
+    InplaceFunction<int()> counter = [count = 0]() mutable { return ++count; };
+
+    EXPECT_EQ(counter(), 1);
+    EXPECT_EQ(counter(), 2);
+}
+
+TEST(InplaceFunctionTest, AcceptsMoveOnlyCallable)
+{
+    auto value = std::make_unique<int>(42);
+    InplaceFunction<int()> function = [value = std::move(value)] { return *value; };
+
+    EXPECT_EQ(function(), 42);
+}
+
+TEST(InplaceFunctionTest, MoveTransfersCallable)
+{
+    int live = 0;
+    {
+        InplaceFunction<int(int)> source = Tracked(&live);
+        EXPECT_EQ(live, 1);
+
+        InplaceFunction<int(int)> destination = std::move(source);
+        EXPECT_FALSE(source);
+        ASSERT_TRUE(destination);
+        EXPECT_EQ(destination(4), 8);
+        EXPECT_EQ(live, 1);
+
+        source = std::move(destination);
+        EXPECT_EQ(source(3), 6);
+        EXPECT_EQ(live, 1);
+    }
+    EXPECT_EQ(live, 0);
+}
+
+TEST(InplaceFunctionTest, NullAssignmentDestroysCallable)
+{
+    int live = 0;
+    InplaceFunction<int(int)> function = Tracked(&live);
+    EXPECT_EQ(live, 1);
+
+    function = nullptr;
+    EXPECT_FALSE(function);
+    EXPECT_EQ(live, 0);
+}
+
+TEST(InplaceFunctionTest, SmallCallablesStoreInline)
+{
+    using Function = InplaceFunction<void(), 16>;
+    auto small = [a = 0, b = 0] { (void)a, (void)b; };
+    auto large = [buffer = std::array<char, 64>{}] { (void)buffer; };
+
+    static_assert(Function::StoresInline<decltype(small)>);
+    static_assert(!Function::StoresInline<decltype(large)>);
+    static_assert(sizeof(Function) == 16 + 2 * sizeof(void *));
+}
+
+TEST(InplaceFunctionTest, HeapFallbackHoldsLargeCallables)
+{
+    int live = 0;
+    {
+        std::array<int, 32> values{};
+        values[31] = 7;
+        InplaceFunction<int(), 16, true> function = [values, tracked = Tracked(&live)] { return values[31]; };
+        EXPECT_EQ(live, 1);
+
+        auto moved = std::move(function);
+        EXPECT_FALSE(function);
+        EXPECT_EQ(moved(), 7);
+        EXPECT_EQ(live, 1);
+    }
+    EXPECT_EQ(live, 0);
+}
@@ -0,0 +1,348 @@
+#include "Kappa/Application.h"
+#include "Kappa/Layer.h"
+#include "Kappa/LayerUpdateGraph.h"
+#include "Kappa/ThreadPool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace Kappa;
+
+namespace
+{
+    struct Positions
+    {
+    };
+
+    struct Velocities
+    {
+    };
+
+    /**
+     * @brief Layer whose declarations are chosen by the test.
+     */
+    class DeclaringLayer : public Layer
+    {
+    public:
+        enum class Access
+        {
+            None,
+            NoSharedState,
+            ReadPositions,
+            WritePositions,
+            WriteVelocities,
+        };
+
+        explicit DeclaringLayer(Access access, std::atomic<int> *updates = nullptr) : updates(updates)
+        {
+            switch (access)
+            {
+            case Access::None:
+                break;
+            case Access::NoSharedState:
+                DeclareNoSharedState();
+                break;
+            case Access::ReadPositions:
+                Reads<Positions>();
+                break;
+            case Access::WritePositions:
+                Writes<Positions>();
+                break;
+            case Access::WriteVelocities:
+                Writes<Velocities>();
+                break;
+            }
+        }
+
+        void OnUpdate(float timestep) override
+        {
+            updateThread = std::this_thread::get_id();
+            lastTimestep = timestep;
+            if (updates)
+            {
+                updates->fetch_add(1);
+            }
+        }
+
+        std::atomic<int> *updates;
+        std::thread::id updateThread;
+        float lastTimestep = 0.0f;
+    };
+
+    /**
+     * @brief Declared-independent layer that waits until a given number of layers are inside OnUpdate().
+     */
+    class RendezvousLayer : public Layer
+    {
+    public:
+        RendezvousLayer(std::atomic<int> *arrived, int expected) : arrived(arrived), expected(expected)
+        {
+            DeclareNoSharedState();
+        }
+
+        void OnUpdate(float) override
+        {
+            arrived->fetch_add(1);
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (arrived->load() < expected && std::chrono::steady_clock::now() < deadline)
+            {
+                std::this_thread::yield();
+            }
+            metEveryone = arrived->load() >= expected;
+        }
+
+        std::atomic<int> *arrived;
+        int expected;
+        bool metEveryone = false;
+    };
+
+    /**
+     * @brief Layer that throws from OnUpdate() while armed, on a worker or on the main thread.
+     */
+    class ThrowingLayer : public Layer
+    {
+    public:
+        explicit ThrowingLayer(bool onWorker)
+        {
+            if (onWorker)
+            {
+                DeclareNoSharedState();
+            }
+        }
+
+        void OnUpdate(float) override
+        {
+            if (armed)
+            {
+                throw std::runtime_error("update failed");
+            }
+        }
+
+        bool armed = true;
+    };
+
+    std::vector<std::unique_ptr<Layer>> MakeLayers(std::initializer_list<DeclaringLayer::Access> accesses,
+                                                   std::atomic<int> *updates = nullptr)
+    {
+        std::vector<std::unique_ptr<Layer>> layers;
+        for (const auto access : accesses)
+        {
+            layers.push_back(std::make_unique<DeclaringLayer>(access, updates));
+        }
+        return layers;
+    }
+
+    struct UpdateRecord
+    {
+        std::atomic<int> updates{ 0 };
+        std::atomic<int> wrongApplication{ 0 };
+        std::atomic<int> offMainThread{ 0 };
+        std::thread::id mainThread = std::this_thread::get_id();
+    };
+
+    /**
+     * @brief Declared-independent layer checking where it updates and which application it sees.
+     */
+    class RecordingLayer : public Layer
+    {
+    public:
+        explicit RecordingLayer(UpdateRecord *record) : record(record), application(&Application::Get())
+        {
+            DeclareNoSharedState();
+        }
+
+        void OnUpdate(float) override
+        {
+            record->updates.fetch_add(1);
+            if (Application::TryGet() != application)
+            {
+                record->wrongApplication.fetch_add(1);
+            }
+            if (std::this_thread::get_id() != record->mainThread)
+            {
+                record->offMainThread.fetch_add(1);
+            }
+        }
+
+        UpdateRecord *record;
+        Application *application;
+    };
+
+    class HeadlessApplication : public Application
+    {
+    public:
+        explicit HeadlessApplication(const ApplicationSpecification &spec) : Application(spec)
+        {
+        }
+
+        template<typename TLayer, typename... Args> void TestPushLayer(Args &&...args)
+        {
+            PushLayer<TLayer>(std::forward<Args>(args)...);
+        }
+    };
+} // namespace
+
+using Access = DeclaringLayer::Access;
+
+TEST(LayerUpdateGraphTest, ReadersAndWritersOfAResourceAreOrdered)
+{
+    const auto layers =
+        MakeLayers({ Access::WritePositions, Access::ReadPositions, Access::ReadPositions, Access::WritePositions });
+    LayerUpdateGraph graph;
+    graph.Build(layers);
+
+    EXPECT_EQ(graph.GetLayerCount(), 4u);
+    EXPECT_TRUE(graph.DependsOn(1, 0));
+    EXPECT_TRUE(graph.DependsOn(2, 0));
+    EXPECT_FALSE(graph.DependsOn(2, 1)); // Readers share
+    EXPECT_TRUE(graph.DependsOn(3, 1));
+    EXPECT_TRUE(graph.DependsOn(3, 2));
+    EXPECT_EQ(graph.GetCriticalPathLength(), 3u);
+}
+
+TEST(LayerUpdateGraphTest, DisjointResourcesAreIndependent)
+{
+    const auto layers = MakeLayers({ Access::WritePositions, Access::WriteVelocities, Access::NoSharedState });
+    LayerUpdateGraph graph;
+    graph.Build(layers);
+
+    EXPECT_FALSE(graph.DependsOn(1, 0));
+    EXPECT_FALSE(graph.DependsOn(2, 0));
+    EXPECT_FALSE(graph.DependsOn(2, 1));
+    EXPECT_EQ(graph.GetCriticalPathLength(), 1u);
+}
+
+TEST(LayerUpdateGraphTest, UndeclaredLayerIsABarrier)
+{
+    const auto layers = MakeLayers({ Access::NoSharedState, Access::None, Access::NoSharedState });
+    LayerUpdateGraph graph;
+    graph.Build(layers);
+
+    EXPECT_TRUE(graph.DependsOn(1, 0));
+    EXPECT_TRUE(graph.DependsOn(2, 1));
+    EXPECT_EQ(graph.GetCriticalPathLength(), 3u);
+}
+
+TEST(LayerUpdateGraphTest, UpdatesEveryLayerOncePerFrame)
+{
+    std::atomic<int> updates{ 0 };
+    const auto layers = MakeLayers({ Access::WritePositions, Access::ReadPositions, Access::None,
+                                     Access::WriteVelocities, Access::NoSharedState, Access::ReadPositions },
+                                   &updates);
+    LayerUpdateGraph graph;
+    graph.Build(layers);
+    ThreadPool pool(3);
+
+    for (int frame = 0; frame < 100; ++frame)
+    {
+        graph.Update(0.25f, pool, nullptr);
+    }
+
+    EXPECT_EQ(updates.load(), 600);
+    for (const auto &layer : layers)
+    {
+        EXPECT_FLOAT_EQ(static_cast<DeclaringLayer &>(*layer).lastTimestep, 0.25f);
+    }
+}
+
+TEST(LayerUpdateGraphTest, UndeclaredLayersStayOnTheCallingThread)
+{
+    const auto layers = MakeLayers({ Access::None, Access::NoSharedState, Access::None });
+    LayerUpdateGraph graph;
+    graph.Build(layers);
+    ThreadPool pool(2);
+
+    for (int frame = 0; frame < 20; ++frame)
+    {
+        graph.Update(0.0f, pool, nullptr);
+        EXPECT_EQ(static_cast<DeclaringLayer &>(*layers[0]).updateThread, std::this_thread::get_id());
+        EXPECT_EQ(static_cast<DeclaringLayer &>(*layers[2]).updateThread, std::this_thread::get_id());
+    }
+}
+
+TEST(LayerUpdateGraphTest, IndependentLayersRunConcurrently)
+{
+    ThreadPool pool(3);
+    std::atomic<int> arrived{ 0 };
+    std::vector<std::unique_ptr<Layer>> layers;
+    for (int i = 0; i < 3; ++i)
+    {
+        layers.push_back(std::make_unique<RendezvousLayer>(&arrived, 3));
+    }
+    LayerUpdateGraph graph;
+    graph.Build(layers);
+
+    graph.Update(0.0f, pool, nullptr);
+
+    for (const auto &layer : layers)
+    {
+        EXPECT_TRUE(static_cast<RendezvousLayer &>(*layer).metEveryone);
+    }
+}
+
+TEST(LayerUpdateGraphTest, ExceptionsReachTheCallerAfterTheFrameSettles)
+{
+    for (const bool onWorker : { true, false })
+    {
+        ThreadPool pool(2);
+        std::atomic<int> updates{ 0 };
+        auto layers = MakeLayers({ Access::NoSharedState, Access::NoSharedState, Access::NoSharedState }, &updates);
+        layers.insert(layers.begin() + 1, std::make_unique<ThrowingLayer>(onWorker));
+        LayerUpdateGraph graph;
+        graph.Build(layers);
+
+        EXPECT_THROW(graph.Update(0.0f, pool, nullptr), std::runtime_error);
+        EXPECT_LE(updates.load(), 3);
+
+        // The graph is reusable once the layer stops throwing
+        static_cast<ThrowingLayer &>(*layers[1]).armed = false;
+        updates.store(0);
+        graph.Update(0.0f, pool, nullptr);
+        EXPECT_EQ(updates.load(), 3);
+    }
+}
+
+TEST(LayerUpdateGraphTest, WorkersSeeTheApplication)
+{
+    ApplicationSpecification spec;
+    spec.headless = true;
+    spec.maxFrames = 20;
+    spec.workerThreadCount = 2;
+    HeadlessApplication app(spec);
+    UpdateRecord first;
+    UpdateRecord second;
+    app.TestPushLayer<RecordingLayer>(&first);
+    app.TestPushLayer<RecordingLayer>(&second);
+
+    app.Run();
+
+    EXPECT_EQ(first.updates.load(), 20);
+    EXPECT_EQ(second.updates.load(), 20);
+    EXPECT_EQ(first.wrongApplication.load(), 0);
+    EXPECT_EQ(second.wrongApplication.load(), 0);
+    EXPECT_EQ(Application::TryGet(), &app);
+}
+
+TEST(LayerUpdateGraphTest, DisablingParallelUpdatesKeepsLayersOnTheMainThread)
+{
+    ApplicationSpecification spec;
+    spec.headless = true;
+    spec.maxFrames = 20;
+    spec.workerThreadCount = 2;
+    spec.parallelLayerUpdates = false;
+    HeadlessApplication app(spec);
+    UpdateRecord record;
+    app.TestPushLayer<RecordingLayer>(&record);
+    app.TestPushLayer<RecordingLayer>(&record);
+
+    app.Run();
+
+    EXPECT_EQ(record.updates.load(), 40);
+    EXPECT_EQ(record.offMainThread.load(), 0);
+}
@@ -0,0 +1,258 @@
+#include "Kappa/Application.h"
+#include "Kappa/Layer.h"
+#include "Kappa/RenderSnapshot.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace Kappa;
+
+namespace
+{
+    struct FrameState
+    {
+        int frame = -1;
+    };
+
+    struct PipelineRecord
+    {
+        std::vector<int> renderedFrames;
+        int updatesOnMainThread = 0;
+        int rendersOffMainThread = 0;
+        std::thread::id mainThread = std::this_thread::get_id();
+    };
+
+    /**
+     * @brief Numbers its updates and renders the number it last published.
+     */
+    class CountingLayer : public Layer
+    {
+    public:
+        explicit CountingLayer(PipelineRecord *record) : record(record)
+        {
+            AddRenderSnapshot(snapshot);
+        }
+
+        void OnUpdate(float) override
+        {
+            if (std::this_thread::get_id() == record->mainThread)
+            {
+                record->updatesOnMainThread++;
+            }
+            snapshot.Write().frame = updates++;
+        }
+
+        void OnRender() override
+        {
+            if (std::this_thread::get_id() != record->mainThread)
+            {
+                record->rendersOffMainThread++;
+            }
+            record->renderedFrames.push_back(snapshot.Read().frame);
+        }
+
+    private:
+        PipelineRecord *record;
+        RenderSnapshot<FrameState> snapshot;
+        int updates = 0;
+    };
+
+    /**
+     * @brief Sleeps in both OnUpdate() and OnRender(), standing in for simulation and render submission.
+     */
+    class SleepingLayer : public Layer
+    {
+    public:
+        void OnUpdate(float) override
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        void OnRender() override
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    };
+
+    class ThrowingLayer : public Layer
+    {
+    public:
+        void OnUpdate(float) override
+        {
+            throw std::runtime_error("update failed");
+        }
+    };
+
+    /**
+     * @brief Throws from OnRender() while armed, right after the simulation thread was handed a frame.
+     */
+    class ThrowingRenderLayer : public Layer
+    {
+    public:
+        explicit ThrowingRenderLayer(std::chrono::milliseconds updateTime) : updateTime(updateTime)
+        {
+        }
+
+        void OnUpdate(float) override
+        {
+            std::this_thread::sleep_for(updateTime);
+            updates++;
+        }
+
+        void OnRender() override
+        {
+            if (armed)
+            {
+                throw std::runtime_error("render failed");
+            }
+        }
+
+        std::chrono::milliseconds updateTime;
+        std::atomic<int> updates{ 0 };
+        bool armed = true;
+    };
+
+    class PipelineApplication : public Application
+    {
+    public:
+        explicit PipelineApplication(const ApplicationSpecification &spec) : Application(spec)
+        {
+        }
+
+        template<typename TLayer, typename... Args> TLayer &TestPushLayer(Args &&...args)
+        {
+            PushLayer<TLayer>(std::forward<Args>(args)...);
+            return static_cast<TLayer &>(*GetLayers().back());
+        }
+    };
+
+    ApplicationSpecification PipelineSpecification(bool pipelined, std::uint64_t frames)
+    {
+        ApplicationSpecification spec;
+        spec.headless = true;
+        spec.headlessRender = true;
+        spec.maxFrames = frames;
+        spec.workerThreadCount = 0;
+        spec.pipelinedRendering = pipelined;
+        return spec;
+    }
+
+    double TimeRun(bool pipelined)
+    {
+        PipelineApplication app(PipelineSpecification(pipelined, 10));
+        app.TestPushLayer<SleepingLayer>();
+
+        const auto start = std::chrono::steady_clock::now();
+        app.Run();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+} // namespace
+
+TEST(RenderSnapshotTest, PublishSwapsBuffers)
+{
+    RenderSnapshot<FrameState> snapshot;
+    EXPECT_EQ(snapshot.Read().frame, -1);
+
+    snapshot.Write().frame = 1;
+    EXPECT_EQ(snapshot.Read().frame, -1);
+
+    snapshot.Publish();
+    EXPECT_EQ(snapshot.Read().frame, 1);
+
+    snapshot.Write().frame = 2;
+    EXPECT_EQ(snapshot.Read().frame, 1);
+    snapshot.Publish();
+    EXPECT_EQ(snapshot.Read().frame, 2);
+}
+
+TEST(PipelinedRenderingTest, SequentialModeRendersTheFrameJustUpdated)
+{
+    PipelineRecord record;
+    PipelineApplication app(PipelineSpecification(false, 4));
+    app.TestPushLayer<CountingLayer>(&record);
+
+    app.Run();
+
+    EXPECT_EQ(record.renderedFrames, (std::vector<int>{ 0, 1, 2, 3 }));
+    EXPECT_EQ(record.updatesOnMainThread, 4);
+}
+
+TEST(PipelinedRenderingTest, PipelinedModeRendersOneFrameBehind)
+{
+    PipelineRecord record;
+    PipelineApplication app(PipelineSpecification(true, 4));
+    app.TestPushLayer<CountingLayer>(&record);
+
+    app.Run();
+
+    EXPECT_EQ(record.renderedFrames, (std::vector<int>{ -1, 0, 1, 2 }));
+    EXPECT_EQ(record.updatesOnMainThread, 0);
+    EXPECT_EQ(record.rendersOffMainThread, 0);
+    EXPECT_EQ(app.GetFrameCount(), 4u);
+}
+
+TEST(PipelinedRenderingTest, RunCanBeRepeated)
+{
+    PipelineRecord record;
+    PipelineApplication app(PipelineSpecification(true, 3));
+    app.TestPushLayer<CountingLayer>(&record);
+
+    app.Run();
+    app.Run();
+
+    // The second run starts by rendering what the first one published last
+    EXPECT_EQ(record.renderedFrames, (std::vector<int>{ -1, 0, 1, 2, 3, 4 }));
+}
+
+TEST(PipelinedRenderingTest, UpdateOverlapsRender)
+{
+    // Ten frames of 10 ms update plus 10 ms render take about 200 ms in sequence and 110 ms pipelined
+    const double sequential = TimeRun(false);
+    const double pipelined = TimeRun(true);
+
+    EXPECT_LT(pipelined, sequential * 0.8);
+}
+
+TEST(PipelinedRenderingTest, UpdateExceptionReachesRun)
+{
+    PipelineApplication app(PipelineSpecification(true, 4));
+    app.TestPushLayer<ThrowingLayer>();
+
+    EXPECT_THROW(app.Run(), std::runtime_error);
+}
+
+TEST(PipelinedRenderingTest, RenderExceptionWaitsForTheSimulatedFrame)
+{
+    // With no update time the simulation thread may not even have taken its frame when OnRender() throws
+    for (const auto updateTime : { std::chrono::milliseconds(0), std::chrono::milliseconds(20) })
+    {
+        PipelineApplication app(PipelineSpecification(true, 3));
+        auto &layer = app.TestPushLayer<ThrowingRenderLayer>(updateTime);
+
+        EXPECT_THROW(app.Run(), std::runtime_error);
+        EXPECT_EQ(layer.updates.load(), 1);
+
+        // The simulation thread was shut down cleanly, so the application can run again
+        layer.armed = false;
+        app.Run();
+        EXPECT_EQ(layer.updates.load(), 4);
+    }
+}
+
+TEST(PipelinedRenderingTest, InterpolationAlphaIsFixedAtPublish)
+{
+    auto spec = PipelineSpecification(true, 3);
+    spec.fixedTimestep = 1.0f / 60.0f;
+    spec.headlessTimestep = 1.0f / 40.0f;
+    PipelineApplication app(spec);
+
+    app.Run();
+
+    // 3 frames of 1/40 s advance 4.5 steps of 1/60 s
+    EXPECT_NEAR(app.GetInterpolationAlpha(), 0.5f, 1e-3f);
+}
@@ -0,0 +1,293 @@
+#include "Kappa/EventBus.h"
+#include "Kappa/Layer.h"
+#include "Kappa/StaticEventBus.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace Kappa;
+
+namespace
+{
+    class MoveEvent : public Event
+    {
+    public:
+        explicit MoveEvent(int val) : value(val)
+        {
+        }
+        int value;
+    };
+
+    class ResizeEvent : public Event
+    {
+    };
+
+    class PointerEvent : public DerivedEvent<PointerEvent>
+    {
+    };
+
+    class ClickEvent : public DerivedEvent<ClickEvent, PointerEvent>
+    {
+    };
+
+    class UnlistedEvent : public Event
+    {
+    };
+
+    class UnlistedClickEvent : public DerivedEvent<UnlistedClickEvent, PointerEvent>
+    {
+    };
+
+    using CoreEventBus = StaticEventBusWithFallback<MoveEvent, ResizeEvent, PointerEvent, ClickEvent>;
+    using StandaloneEventBus = StaticEventBus<MoveEvent, PointerEvent>;
+
+    static_assert(CoreEventBus::Handles<MoveEvent>);
+    static_assert(CoreEventBus::Handles<ClickEvent>);
+    static_assert(!CoreEventBus::Handles<UnlistedEvent>);
+    static_assert(CoreEventBus::HasFallback);
+    static_assert(!StandaloneEventBus::HasFallback);
+
+    // Only the layered bus can be built on top of a dynamic bus
+    static_assert(std::is_constructible_v<CoreEventBus, EventBus &>);
+    static_assert(!std::is_default_constructible_v<CoreEventBus>);
+    static_assert(std::is_default_constructible_v<StandaloneEventBus>);
+    static_assert(!std::is_constructible_v<StandaloneEventBus, EventBus &>);
+} // namespace
+
+// ============================================================================
+// StaticEventBus Tests
+// ============================================================================
+
+class StaticEventBusTest : public ::testing::Test
+{
+protected:
+    EventBus dynamicBus;
+    CoreEventBus bus{ dynamicBus };
+    std::vector<Subscription> subscriptions; // Destroyed before the buses
+};
+
+TEST_F(StaticEventBusTest, PublishReachesSubscribersOfThatTypeOnly)
+{
+    int moved = 0;
+    int resized = 0;
+    subscriptions.push_back(bus.Subscribe<MoveEvent>([&moved](const MoveEvent &event) { moved += event.value; }));
+    subscriptions.push_back(bus.Subscribe<ResizeEvent>([&resized](const ResizeEvent &) { resized++; }));
+
+    bus.Publish(MoveEvent(3));
+    bus.Publish(MoveEvent(4));
+
+    EXPECT_EQ(moved, 7);
+    EXPECT_EQ(resized, 0);
+    EXPECT_EQ(bus.GetSubscriberCount<MoveEvent>(), 1u);
+}
+
+TEST_F(StaticEventBusTest, PrioritiesOrderHandlersAndHandledStopsDispatch)
+{
+    std::vector<std::string> order;
+    subscriptions.push_back(bus.Subscribe<MoveEvent>([&order](const MoveEvent &) { order.push_back("low"); }, -1));
+    subscriptions.push_back(bus.Subscribe<MoveEvent>(
+        [&order](const MoveEvent &event) {
+            order.push_back("high");
+            return event.value > 0;
+        },
+        5));
+    subscriptions.push_back(bus.Subscribe<MoveEvent>([&order](const MoveEvent &) { order.push_back("normal"); }));
+
+    EXPECT_FALSE(bus.Publish(MoveEvent(0)));
+    EXPECT_EQ(order, (std::vector<std::string>{ "high", "normal", "low" }));
+
+    order.clear();
+    EXPECT_TRUE(bus.Publish(MoveEvent(1)));
+    EXPECT_EQ(order, (std::vector<std::string>{ "high" }));
+}
+
+TEST_F(StaticEventBusTest, ResettingTokenUnsubscribes)
+{
+    int calls = 0;
+    auto subscription = bus.Subscribe<MoveEvent>([&calls](const MoveEvent &) { calls++; });
+
+    bus.Publish(MoveEvent(1));
+    subscription.Reset();
+    bus.Publish(MoveEvent(1));
+
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(bus.GetSubscriberCount<MoveEvent>(), 0u);
+}
+
+TEST_F(StaticEventBusTest, UnlistedEventsUseFallbackBus)
+{
+    int calls = 0;
+    subscriptions.push_back(bus.Subscribe<UnlistedEvent>([&calls](const UnlistedEvent &) { calls++; }));
+
+    bus.Publish(UnlistedEvent());
+    dynamicBus.Publish(UnlistedEvent());
+
+    EXPECT_EQ(calls, 2);
+}
+
+TEST(StaticEventBusStandaloneTest, ListedPartsOfAnEventChainStillDispatch)
+{
+    // Subscribing to or publishing UnlistedEvent here would not compile
+    StandaloneEventBus bus;
+    int pointers = 0;
+    auto subscription = bus.Subscribe<PointerEvent>([&pointers](const PointerEvent &) { pointers++; });
+
+    EXPECT_FALSE(bus.Publish(UnlistedClickEvent()));
+    EXPECT_EQ(pointers, 1);
+    EXPECT_EQ(bus.GetFallbackBus(), nullptr);
+}
+
+TEST_F(StaticEventBusTest, DerivedEventsReachListedParents)
+{
+    std::vector<std::string> order;
+    subscriptions.push_back(
+        bus.Subscribe<PointerEvent>([&order](const PointerEvent &) { order.push_back("pointer"); }));
+    subscriptions.push_back(bus.Subscribe<ClickEvent>([&order](const ClickEvent &) { order.push_back("click"); }));
+
+    bus.Publish(ClickEvent());
+
+    EXPECT_EQ(order, (std::vector<std::string>{ "click", "pointer" }));
+}
+
+TEST_F(StaticEventBusTest, SubscribeDuringDispatchTakesEffectWithNextEvent)
+{
+    int lateCalls = 0;
+    subscriptions.push_back(bus.Subscribe<MoveEvent>([this, &lateCalls](const MoveEvent &) {
+        if (subscriptions.size() == 1)
+        {
+            subscriptions.push_back(bus.Subscribe<MoveEvent>([&lateCalls](const MoveEvent &) { lateCalls++; }));
+        }
+    }));
+
+    bus.Publish(MoveEvent(1));
+    EXPECT_EQ(lateCalls, 0);
+
+    bus.Publish(MoveEvent(1));
+    EXPECT_EQ(lateCalls, 1);
+}
+
+TEST_F(StaticEventBusTest, UnsubscribeDuringDispatchSkipsRemovedHandler)
+{
+    int laterCalls = 0;
+    Subscription later;
+    subscriptions.push_back(bus.Subscribe<MoveEvent>([&later](const MoveEvent &) { later.Reset(); }, 1));
+    later = bus.Subscribe<MoveEvent>([&laterCalls](const MoveEvent &) { laterCalls++; });
+
+    bus.Publish(MoveEvent(1));
+
+    EXPECT_EQ(laterCalls, 0);
+    EXPECT_EQ(bus.GetSubscriberCount<MoveEvent>(), 1u);
+}
+
+TEST_F(StaticEventBusTest, HandlerUnsubscribingItselfKeepsItsCaptures)
+{
+    Subscription self;
+    std::string seen;
+    // Long enough to live on the heap, so a destroyed capture would be caught by the sanitizers
+    self = bus.Subscribe<MoveEvent>([&self, &seen, label = std::string(64, 'x')](const MoveEvent &) {
+        self.Reset();
+        seen = label;
+    });
+
+    bus.Publish(MoveEvent(1));
+    bus.Publish(MoveEvent(2));
+
+    EXPECT_EQ(seen, std::string(64, 'x'));
+    EXPECT_EQ(bus.GetSubscriberCount<MoveEvent>(), 0u);
+}
+
+TEST_F(StaticEventBusTest, HandlerClearingTheBusKeepsItsCaptures)
+{
+    std::string seen;
+    auto subscription = bus.Subscribe<MoveEvent>([this, &seen, label = std::string(64, 'y')](const MoveEvent &) {
+        bus.Clear();
+        seen = label;
+    });
+
+    bus.Publish(MoveEvent(1));
+
+    EXPECT_EQ(seen, std::string(64, 'y'));
+    EXPECT_EQ(bus.GetSubscriberCount<MoveEvent>(), 0u);
+}
+
+TEST_F(StaticEventBusTest, ThrowingHandlerLeavesTheBusUsable)
+{
+    Subscription removed;
+    subscriptions.push_back(bus.Subscribe<MoveEvent>(
+        [&removed](const MoveEvent &) {
+            removed.Reset();
+            throw std::runtime_error("handler failed");
+        },
+        1));
+    int removedCalls = 0;
+    removed = bus.Subscribe<MoveEvent>([&removedCalls](const MoveEvent &) { removedCalls++; });
+
+    EXPECT_THROW(bus.Publish(MoveEvent(1)), std::runtime_error);
+    subscriptions.front().Reset();
+
+    // Subscribing after the failed publish takes effect immediately, and the removal was applied
+    int calls = 0;
+    subscriptions.push_back(bus.Subscribe<MoveEvent>([&calls](const MoveEvent &) { calls++; }));
+    bus.Publish(MoveEvent(2));
+    bus.Publish(MoveEvent(3));
+
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(removedCalls, 0);
+    EXPECT_EQ(bus.GetSubscriberCount<MoveEvent>(), 1u);
+}
+
+TEST_F(StaticEventBusTest, EnqueuedEventsWaitForDispatch)
+{
+    std::vector<int> received;
+    subscriptions.push_back(
+        bus.Subscribe<MoveEvent>([&received](const MoveEvent &event) { received.push_back(event.value); }));
+
+    bus.Enqueue<MoveEvent>(1);
+    bus.Enqueue<MoveEvent>(2);
+    EXPECT_TRUE(received.empty());
+
+    bus.DispatchQueued();
+    EXPECT_EQ(received, (std::vector<int>{ 1, 2 }));
+
+    bus.DispatchQueued();
+    EXPECT_EQ(received.size(), 2u);
+}
+
+TEST_F(StaticEventBusTest, ClearLeavesTokensHarmless)
+{
+    int calls = 0;
+    auto subscription = bus.Subscribe<MoveEvent>([&calls](const MoveEvent &) { calls++; });
+
+    bus.Clear();
+    bus.Publish(MoveEvent(1));
+    subscription.Reset();
+
+    EXPECT_EQ(calls, 0);
+    EXPECT_EQ(bus.GetSubscriberCount<MoveEvent>(), 0u);
+}
+
+TEST_F(StaticEventBusTest, LayerScopedSubscriptionEndsWithLayer)
+{
+    class ListeningLayer : public Layer
+    {
+    public:
+        ListeningLayer(CoreEventBus &bus, int &calls)
+        {
+            bus.Subscribe<MoveEvent>(*this, [&calls](const MoveEvent &) { calls++; });
+        }
+    };
+
+    int calls = 0;
+    auto layer = std::make_unique<ListeningLayer>(bus, calls);
+
+    bus.Publish(MoveEvent(1));
+    layer.reset();
+    bus.Publish(MoveEvent(1));
+
+    EXPECT_EQ(calls, 1);
+}
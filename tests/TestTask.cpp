@@ -0,0 +1,341 @@
+#include "Kappa/EventBus.h"
+#include "Kappa/Layer.h"
+#include "Kappa/Task.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Kappa;
+
+namespace
+{
+    class LoadedEvent : public Event
+    {
+    public:
+        explicit LoadedEvent(int id) : id(id)
+        {
+        }
+        int id;
+    };
+} // namespace
+
+// ============================================================================
+// Task Tests
+// ============================================================================
+
+class TaskTest : public ::testing::Test
+{
+protected:
+    EventBus bus;
+    TaskScheduler scheduler; // Destroyed before the bus, dropping awaiter subscriptions
+    std::vector<Subscription> tasks;
+};
+
+TEST_F(TaskTest, SpawnRunsUntilFirstSuspension)
+{
+    std::vector<std::string> steps;
+    auto body = [&steps]() -> Task<> {
+        steps.push_back("start");
+        co_await NextFrame();
+        steps.push_back("resumed");
+    };
+
+    tasks.push_back(scheduler.Spawn(body()));
+    EXPECT_EQ(steps, std::vector<std::string>({ "start" }));
+    EXPECT_EQ(scheduler.GetTaskCount(), 1u);
+
+    scheduler.Update(0.016f);
+    EXPECT_EQ(steps, std::vector<std::string>({ "start", "resumed" }));
+    EXPECT_EQ(scheduler.GetTaskCount(), 0u);
+}
+
+TEST_F(TaskTest, NextFrameWaitsOneUpdateEach)
+{
+    int frames = 0;
+    auto body = [&frames]() -> Task<> {
+        for (int i = 0; i < 3; ++i)
+        {
+            co_await NextFrame();
+            frames++;
+        }
+    };
+
+    tasks.push_back(scheduler.Spawn(body()));
+    for (int update = 1; update <= 3; ++update)
+    {
+        scheduler.Update(0.016f);
+        EXPECT_EQ(frames, update);
+    }
+}
+
+TEST_F(TaskTest, DelayUsesSchedulerClock)
+{
+    bool done = false;
+    auto body = [&done]() -> Task<> {
+        co_await Delay(0.5);
+        done = true;
+    };
+
+    tasks.push_back(scheduler.Spawn(body()));
+    scheduler.Update(0.25f);
+    EXPECT_FALSE(done);
+    scheduler.Update(0.25f);
+    EXPECT_TRUE(done);
+    EXPECT_DOUBLE_EQ(scheduler.GetTime(), 0.5);
+}
+
+TEST_F(TaskTest, ReportsPendingWork)
+{
+    EXPECT_FALSE(scheduler.HasReadyTasks());
+    EXPECT_EQ(scheduler.GetTimeUntilNextTimer(), std::numeric_limits<double>::infinity());
+
+    auto nextFrame = []() -> Task<> { co_await NextFrame(); };
+    auto delay = []() -> Task<> { co_await Delay(0.5); };
+    tasks.push_back(scheduler.Spawn(nextFrame()));
+    tasks.push_back(scheduler.Spawn(delay()));
+
+    EXPECT_TRUE(scheduler.HasReadyTasks());
+    EXPECT_DOUBLE_EQ(scheduler.GetTimeUntilNextTimer(), 0.5);
+
+    scheduler.Update(0.2f);
+    EXPECT_FALSE(scheduler.HasReadyTasks());
+    EXPECT_NEAR(scheduler.GetTimeUntilNextTimer(), 0.3, 1e-6);
+}
+
+TEST_F(TaskTest, DelaysWakeInDeadlineOrder)
+{
+    std::vector<int> order;
+    auto body = [&order](double seconds, int id) -> Task<> {
+        co_await Delay(seconds);
+        order.push_back(id);
+    };
+
+    tasks.push_back(scheduler.Spawn(body(0.3, 3)));
+    tasks.push_back(scheduler.Spawn(body(0.1, 1)));
+    tasks.push_back(scheduler.Spawn(body(0.2, 2)));
+    scheduler.Update(1.0f);
+
+    EXPECT_EQ(order, std::vector<int>({ 1, 2, 3 }));
+}
+
+TEST_F(TaskTest, NextEventResumesWithPublishedEvent)
+{
+    int loadedId = 0;
+    auto body = [this, &loadedId]() -> Task<> {
+        const auto event = co_await bus.Next<LoadedEvent>();
+        loadedId = event.id;
+    };
+
+    tasks.push_back(scheduler.Spawn(body()));
+    bus.Publish(LoadedEvent(7));
+    bus.Publish(LoadedEvent(8)); // Only the first event after suspension is delivered
+    EXPECT_EQ(loadedId, 0);
+
+    scheduler.Update(0.016f);
+    EXPECT_EQ(loadedId, 7);
+    EXPECT_EQ(scheduler.GetTaskCount(), 0u);
+}
+
+TEST_F(TaskTest, AwaitedTasksReturnValuesAndExceptions)
+{
+    auto load = [](int value) -> Task<int> {
+        co_await NextFrame();
+        co_return value * 2;
+    };
+    auto fail = []() -> Task<int> {
+        co_await NextFrame();
+        throw std::runtime_error("missing asset");
+    };
+
+    int result = 0;
+    std::string error;
+    auto body = [&]() -> Task<> {
+        result = co_await load(21);
+        try
+        {
+            co_await fail();
+        }
+        catch (const std::runtime_error &exception)
+        {
+            error = exception.what();
+        }
+    };
+
+    tasks.push_back(scheduler.Spawn(body()));
+    scheduler.Update(0.016f);
+    EXPECT_EQ(result, 42);
+    scheduler.Update(0.016f);
+    EXPECT_EQ(error, "missing asset");
+    EXPECT_EQ(scheduler.GetTaskCount(), 0u);
+}
+
+TEST_F(TaskTest, ResettingTokenCancelsTaskAndItsAwaiters)
+{
+    bool resumed = false;
+    auto body = [this, &resumed]() -> Task<> {
+        co_await bus.Next<LoadedEvent>();
+        resumed = true;
+    };
+
+    auto task = scheduler.Spawn(body());
+    task.Reset();
+    EXPECT_EQ(scheduler.GetTaskCount(), 0u);
+
+    // The awaiter's subscription went away with the frame
+    bus.Publish(LoadedEvent(1));
+    scheduler.Update(0.016f);
+    EXPECT_FALSE(resumed);
+}
+
+TEST_F(TaskTest, CancellingAfterWakeupSkipsResumption)
+{
+    bool resumed = false;
+    auto body = [&resumed]() -> Task<> {
+        co_await NextFrame();
+        resumed = true;
+    };
+
+    auto task = scheduler.Spawn(body());
+    task.Reset();
+    tasks.push_back(scheduler.Spawn(body())); // Reuses the slot with a new generation
+    scheduler.Update(0.016f);
+
+    EXPECT_TRUE(resumed);
+    EXPECT_EQ(scheduler.GetTaskCount(), 0u);
+}
+
+TEST_F(TaskTest, TaskCanCancelItself)
+{
+    int steps = 0;
+    Subscription self;
+    auto body = [&steps, &self]() -> Task<> {
+        co_await NextFrame();
+        steps++;
+        self.Reset();
+        co_await NextFrame();
+        steps++;
+    };
+
+    self = scheduler.Spawn(body());
+    scheduler.Update(0.016f);
+    scheduler.Update(0.016f);
+
+    EXPECT_EQ(steps, 1);
+    EXPECT_EQ(scheduler.GetTaskCount(), 0u);
+}
+
+TEST_F(TaskTest, LayerScopedTaskEndsWithLayer)
+{
+    class FadeLayer : public Layer
+    {
+    public:
+        FadeLayer(TaskScheduler &scheduler, int &frames)
+        {
+            scheduler.Spawn(*this, Fade(frames));
+        }
+
+    private:
+        static Task<> Fade(int &frames)
+        {
+            while (true)
+            {
+                co_await NextFrame();
+                frames++;
+            }
+        }
+    };
+
+    int frames = 0;
+    auto layer = std::make_unique<FadeLayer>(scheduler, frames);
+    scheduler.Update(0.016f);
+    layer.reset();
+    scheduler.Update(0.016f);
+
+    EXPECT_EQ(frames, 1);
+    EXPECT_EQ(scheduler.GetTaskCount(), 0u);
+}
+
+TEST_F(TaskTest, EventsFromWorkerThreadsWakeTasks)
+{
+    int loadedId = 0;
+    auto body = [this, &loadedId]() -> Task<> { loadedId = (co_await bus.Next<LoadedEvent>()).id; };
+
+    tasks.push_back(scheduler.Spawn(body()));
+    std::thread worker([this] { bus.Publish(LoadedEvent(5)); });
+    worker.join();
+    scheduler.Update(0.016f);
+
+    EXPECT_EQ(loadedId, 5);
+}
+
+TEST_F(TaskTest, LatePublisherDoesNotTouchFinishedAwaiter)
+{
+    int loadedId = 0;
+    auto body = [this, &loadedId]() -> Task<> { loadedId = (co_await bus.Next<LoadedEvent>()).id; };
+
+    // Holds a worker's publish between loading the handler snapshot and reaching the awaiter's handler
+    const auto mainThread = std::this_thread::get_id();
+    std::atomic<bool> workerInside = false;
+    std::atomic<bool> release = false;
+    auto gate = bus.Subscribe<LoadedEvent>(
+        [&](const LoadedEvent &) {
+            if (std::this_thread::get_id() != mainThread)
+            {
+                workerInside = true;
+                while (!release)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        },
+        1);
+
+    tasks.push_back(scheduler.Spawn(body()));
+    std::thread worker([this] { bus.Publish(LoadedEvent(2)); });
+    while (!workerInside)
+    {
+        std::this_thread::yield();
+    }
+
+    // Wake and finish the task, destroying the awaiter, while the worker still holds the old snapshot
+    bus.Publish(LoadedEvent(1));
+    scheduler.Update(0.016f);
+    EXPECT_EQ(loadedId, 1);
+
+    release = true;
+    worker.join();
+    scheduler.Update(0.016f);
+
+    EXPECT_EQ(loadedId, 1);
+    EXPECT_EQ(scheduler.GetTaskCount(), 0u);
+}
+
+TEST_F(TaskTest, ManyTasksRecycleFrames)
+{
+    constexpr int taskCount = 10000;
+    int finished = 0;
+    auto body = [&finished]() -> Task<> {
+        co_await NextFrame();
+        finished++;
+    };
+
+    for (int round = 0; round < 2; ++round)
+    {
+        for (int i = 0; i < taskCount; ++i)
+        {
+            tasks.push_back(scheduler.Spawn(body()));
+        }
+        scheduler.Update(0.016f);
+        tasks.clear();
+    }
+
+    EXPECT_EQ(finished, 2 * taskCount);
+    EXPECT_EQ(scheduler.GetTaskCount(), 0u);
+}
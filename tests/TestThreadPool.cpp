@@ -0,0 +1,215 @@
+#include "Kappa/ThreadPool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace Kappa;
+
+// ============================================================================
+// ThreadPool Tests
+// ============================================================================
+
+TEST(ThreadPoolTest, SubmitRunsTasks)
+{
+    std::atomic<int> runs = 0;
+    {
+        ThreadPool pool(2);
+        for (int i = 0; i < 100; ++i)
+        {
+            pool.Submit([&runs] { runs++; });
+        }
+    } // Destructor finishes queued tasks
+
+    EXPECT_EQ(runs, 100);
+}
+
+TEST(ThreadPoolTest, ZeroWorkersRunInline)
+{
+    ThreadPool pool(0);
+    int runs = 0;
+
+    pool.Submit([&runs] { runs++; });
+    pool.ParallelFor(10, [&runs](std::size_t) { runs++; });
+
+    EXPECT_EQ(pool.GetWorkerCount(), 0u);
+    EXPECT_EQ(runs, 11);
+}
+
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce)
+{
+    ThreadPool pool(4);
+    constexpr std::size_t count = 10000;
+    std::vector<std::atomic<int>> visits(count);
+
+    pool.ParallelFor(count, [&visits](std::size_t i) { visits[i]++; });
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        ASSERT_EQ(visits[i], 1) << "index " << i;
+    }
+}
+
+TEST(ThreadPoolTest, NestedParallelForDoesNotDeadlock)
+{
+    ThreadPool pool(2);
+    std::atomic<int> total = 0;
+
+    pool.ParallelFor(8, [&](std::size_t) { pool.ParallelFor(8, [&total](std::size_t) { total++; }); });
+
+    EXPECT_EQ(total, 64);
+}
+
+TEST(ThreadPoolTest, ParallelForRethrowsAfterHelpersFinish)
+{
+    ThreadPool pool(3);
+    std::atomic<int> inFlight = 0;
+
+    EXPECT_THROW(pool.ParallelFor(1000, 1,
+                                  [&inFlight](std::size_t i) {
+                                      inFlight++;
+                                      std::this_thread::sleep_for(std::chrono::microseconds(50));
+                                      inFlight--;
+                                      if (i == 10)
+                                      {
+                                          throw std::runtime_error("body failed");
+                                      }
+                                  }),
+                 std::runtime_error);
+
+    // Every call has returned before the exception reached the caller
+    EXPECT_EQ(inFlight, 0);
+
+    std::atomic<int> total = 0;
+    pool.ParallelFor(100, [&total](std::size_t) { total++; });
+    EXPECT_EQ(total, 100);
+}
+
+TEST(ThreadPoolTest, ParallelForHonoursGrainSize)
+{
+    ThreadPool pool(3);
+    constexpr std::size_t count = 1000;
+    std::vector<std::atomic<int>> visits(count);
+    std::vector<std::thread::id> owners(count);
+
+    pool.ParallelFor(count, 7, [&](std::size_t i) {
+        visits[i]++;
+        owners[i] = std::this_thread::get_id();
+    });
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        ASSERT_EQ(visits[i], 1) << "index " << i;
+        // Indices of one chunk run on one thread
+        if (i % 7 != 0)
+        {
+            ASSERT_EQ(owners[i], owners[i - 1]) << "index " << i;
+        }
+    }
+}
+
+TEST(ThreadPoolTest, TasksSubmittedByWorkersAllRun)
+{
+    ThreadPool pool(4);
+    std::atomic<int> runs = 0;
+
+    auto root = pool.Submit(
+        [&pool, &runs] {
+            // Children land on this worker's deque; idle workers steal them
+            for (int i = 0; i < 1000; ++i)
+            {
+                pool.Submit([&runs] { runs++; });
+            }
+        },
+        {});
+    pool.Wait(root);
+
+    while (runs.load() != 1000)
+    {
+        pool.TryRunPending();
+    }
+    EXPECT_EQ(runs, 1000);
+}
+
+TEST(ThreadPoolTest, DependenciesRunFirst)
+{
+    ThreadPool pool(4);
+    std::atomic<int> finishedParents = 0;
+    int parentsSeenByChild = -1;
+
+    const auto first = pool.Submit([&finishedParents] { finishedParents++; }, {});
+    const auto second = pool.Submit([&finishedParents] { finishedParents++; }, {});
+    const auto child = pool.Submit(
+        [&finishedParents, &parentsSeenByChild] { parentsSeenByChild = finishedParents.load(); }, { first, second });
+    pool.Wait(child);
+
+    EXPECT_TRUE(first.IsDone());
+    EXPECT_TRUE(second.IsDone());
+    EXPECT_EQ(parentsSeenByChild, 2);
+}
+
+TEST(ThreadPoolTest, ContinuationsRunInOrder)
+{
+    ThreadPool pool(2);
+    std::vector<int> order;
+
+    auto job = pool.Submit([&order] { order.push_back(0); }, {});
+    for (int i = 1; i < 100; ++i)
+    {
+        job = pool.Then(job, [&order, i] { order.push_back(i); });
+    }
+    pool.Wait(job);
+
+    ASSERT_EQ(order.size(), 100u);
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(order[static_cast<std::size_t>(i)], i);
+    }
+}
+
+TEST(ThreadPoolTest, WaitRunsJobsOnCallingThread)
+{
+    ThreadPool pool(1);
+    std::atomic<bool> occupied = false;
+    std::atomic<bool> release = false;
+
+    // Occupy the only worker until the job has run
+    pool.Submit([&occupied, &release] {
+        occupied = true;
+        while (!release.load())
+        {
+            std::this_thread::yield();
+        }
+    });
+    while (!occupied.load())
+    {
+        std::this_thread::yield();
+    }
+
+    std::thread::id ranOn;
+    const auto job = pool.Submit([&ranOn] { ranOn = std::this_thread::get_id(); }, {});
+    pool.Wait(job);
+    release = true;
+
+    EXPECT_EQ(ranOn, std::this_thread::get_id());
+}
+
+TEST(ThreadPoolTest, FinishedOrEmptyDependenciesDontBlock)
+{
+    ThreadPool pool(0);
+    int runs = 0;
+
+    const auto done = pool.Submit([&runs] { runs++; }, {});
+    EXPECT_TRUE(done.IsDone());
+
+    const auto next = pool.Submit([&runs] { runs++; }, { done, JobHandle() });
+    EXPECT_TRUE(next.IsDone());
+    EXPECT_EQ(runs, 2);
+    EXPECT_FALSE(JobHandle().IsValid());
+    EXPECT_TRUE(JobHandle().IsDone());
+}